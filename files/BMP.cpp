@@ -1,63 +1,108 @@
 #include "BMP.h"
+#include "Kernels.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
 #include <vector>
-#include <algorithm>
 
 constexpr uint16_t KBmpSignature = 0x4D42;
 constexpr uint32_t KHeaderSize = 40;
 constexpr uint16_t KBitsPerPixel = 24;
 constexpr uint32_t KOffset = 54;
-constexpr float KMaxColorValue = 255.0f;
 
-Image ReadBMP(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        throw std::runtime_error("Cannot open file: " + filename);
-    }
+namespace {
+
+struct BMPLayout {
+    size_t width;
+    size_t height;
+    size_t offset;
+    size_t row_size;
+    size_t end;
+};
 
+BMPLayout ParseHeaders(const uint8_t* data, size_t size) {
+    if (size < KOffset) {
+        throw std::runtime_error("Truncated BMP header");
+    }
     BMPFileHeader file_header;
     BMPInfoHeader info_header;
-    file.read(reinterpret_cast<char*>(&file_header), sizeof(file_header));
-    file.read(reinterpret_cast<char*>(&info_header), sizeof(info_header));
+    std::memcpy(&file_header, data, sizeof(file_header));
+    std::memcpy(&info_header, data + sizeof(file_header), sizeof(info_header));
 
     if (file_header.signature != KBmpSignature) {
-        throw std::runtime_error("Not a BMP file: " + filename);
+        throw std::runtime_error("Not a BMP file");
     }
     if (info_header.header_size != KHeaderSize) {
-        throw std::runtime_error("Unsupported BMP header: " + filename);
+        throw std::runtime_error("Unsupported BMP header");
     }
     if (info_header.bits_per_pixel != KBitsPerPixel) {
-        throw std::runtime_error("Not a 24-bit BMP: " + filename);
+        throw std::runtime_error("Not a 24-bit BMP");
     }
     if (info_header.compression != 0) {
-        throw std::runtime_error("Compressed BMP not supported: " + filename);
+        throw std::runtime_error("Compressed BMP not supported");
+    }
+    if (info_header.width < 0) {
+        throw std::runtime_error("Invalid BMP width");
     }
 
-    size_t width = static_cast<size_t>(std::abs(info_header.width));
-    size_t height = static_cast<size_t>(std::abs(info_header.height));
-    Image image(width, height);
+    BMPLayout layout;
+    layout.width = static_cast<size_t>(info_header.width);
+    layout.height = static_cast<size_t>(std::abs(static_cast<int64_t>(info_header.height)));
+    if (layout.width > KMaxBMPDimension || layout.height > KMaxBMPDimension ||
+        (layout.height != 0 && layout.width > KMaxBMPPixels / layout.height)) {
+        throw std::runtime_error("BMP image too large");
+    }
+    layout.offset = file_header.offset;
+    if (layout.offset < KOffset) {
+        throw std::runtime_error("Invalid BMP pixel data offset");
+    }
+    layout.row_size = (layout.width * 3 + 3) / 4 * 4;
+    layout.end = layout.offset + layout.row_size * layout.height;
+    return layout;
+}
 
-    file.seekg(file_header.offset, std::ios::beg);
-    size_t padding = (4 - (width * 3) % 4) % 4;
-    std::vector<unsigned char> pixel_data(width * 3);
-    for (size_t y = 0; y < height; ++y) {
-        file.read(reinterpret_cast<char*>(pixel_data.data()), static_cast<std::streamsize>(width * 3));
-        file.seekg(static_cast<std::streamoff>(padding), std::ios::cur);
-        for (size_t x = 0; x < width; ++x) {
-            size_t offset = x * 3;
-            unsigned char b = pixel_data[offset];
-            unsigned char g = pixel_data[offset + 1];
-            unsigned char r = pixel_data[offset + 2];
-            image.SetPixel(x, y,
-                           Pixel(static_cast<float>(r) / KMaxColorValue, static_cast<float>(g) / KMaxColorValue,
-                                 static_cast<float>(b) / KMaxColorValue));
-        }
+}  // namespace
+
+Image DecodeBMP(const uint8_t* data, size_t size, const kernels::KernelTable& table) {
+    BMPLayout layout = ParseHeaders(data, size);
+    if (size < layout.end) {
+        throw std::runtime_error("Truncated BMP pixel data");
+    }
+    Image image(layout.width, layout.height);
+    for (size_t y = 0; y < layout.height; ++y) {
+        table.decode_bgr_row(data + layout.offset + y * layout.row_size, image.GetRow(y), layout.width);
     }
     return image;
 }
 
-void WriteBMP(const std::string& filename, const Image& image) {
+Image ReadBMP(const std::string& filename, const kernels::KernelTable& table) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    size_t file_size = static_cast<size_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+    try {
+        std::vector<uint8_t> data(std::min(file_size, static_cast<size_t>(KOffset)));
+        file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        BMPLayout layout = ParseHeaders(data.data(), static_cast<size_t>(file.gcount()));
+        if (file_size < layout.end) {
+            throw std::runtime_error("Truncated BMP pixel data");
+        }
+        data.resize(layout.end);
+        file.read(reinterpret_cast<char*>(data.data() + KOffset), static_cast<std::streamsize>(layout.end - KOffset));
+        if (static_cast<size_t>(file.gcount()) != layout.end - KOffset) {
+            throw std::runtime_error("Truncated BMP pixel data");
+        }
+        return DecodeBMP(data.data(), data.size(), table);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string(e.what()) + ": " + filename);
+    }
+}
+
+void WriteBMP(const std::string& filename, const Image& image, const kernels::KernelTable& table) {
     size_t width = image.GetWidth();
     size_t height = image.GetHeight();
     size_t padding = (4 - (width * 3) % 4) % 4;
@@ -77,15 +122,7 @@ void WriteBMP(const std::string& filename, const Image& image) {
     std::vector<unsigned char> pixel_data(pixel_data_size, 0);
     for (size_t y = 0; y < height; ++y) {
         size_t offset = y * (width * 3 + padding);
-        for (size_t x = 0; x < width; ++x) {
-            Pixel p = image.GetPixel(static_cast<int>(x), static_cast<int>(y));
-            pixel_data[offset + x * 3] =
-                static_cast<unsigned char>(std::clamp(p.b * KMaxColorValue, 0.0f, KMaxColorValue));
-            pixel_data[offset + x * 3 + 1] =
-                static_cast<unsigned char>(std::clamp(p.g * KMaxColorValue, 0.0f, KMaxColorValue));
-            pixel_data[offset + x * 3 + 2] =
-                static_cast<unsigned char>(std::clamp(p.r * KMaxColorValue, 0.0f, KMaxColorValue));
-        }
+        table.encode_bgr_row(image.GetRow(y), pixel_data.data() + offset, width);
     }
     file.write(reinterpret_cast<const char*>(pixel_data.data()), static_cast<std::streamsize>(pixel_data_size));
 }
\ No newline at end of file
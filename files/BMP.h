@@ -2,6 +2,7 @@
 
 #include <string>
 #include "Image.h"
+#include "Kernels.h"
 #include <cstdint>
 
 #pragma pack(push, 1)
@@ -28,5 +29,13 @@ struct BMPInfoHeader {
 };
 #pragma pack(pop)
 
-Image ReadBMP(const std::string& filename);
-void WriteBMP(const std::string& filename, const Image& image);
\ No newline at end of file
+// Decoding refuses larger images before allocating anything.
+constexpr size_t KMaxBMPDimension = size_t{1} << 20;
+constexpr size_t KMaxBMPPixels = size_t{1} << 28;
+
+// Decodes a complete 24-bit BMP file held in memory. Throws std::runtime_error on
+// malformed, truncated or oversized input.
+Image DecodeBMP(const uint8_t* data, size_t size, const kernels::KernelTable& table = kernels::GetKernels());
+Image ReadBMP(const std::string& filename, const kernels::KernelTable& table = kernels::GetKernels());
+void WriteBMP(const std::string& filename, const Image& image,
+              const kernels::KernelTable& table = kernels::GetKernels());
\ No newline at end of file
@@ -2,10 +2,21 @@
 #define FILTER_H
 
 #include "Image.h"
+#include "Kernels.h"
+#include <optional>
 
 class Filter {
 public:
-    virtual Image Apply(const Image& input) const = 0;
+    Image Apply(const Image& input) const {
+        return Apply(input, kernels::GetKernels());
+    }
+    // Runs the row loops through `table`, so a caller can force a kernel variant for this call only.
+    virtual Image Apply(const Image& input, const kernels::KernelTable& table) const = 0;
+    // Part of a width x height input that the output pixels in `output` depend on. Filters that change the
+    // image size or need the whole image return std::nullopt and cannot be run tile by tile.
+    virtual std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const {
+        return std::nullopt;
+    }
     virtual ~Filter() = default;
 };
 
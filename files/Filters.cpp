@@ -1,15 +1,56 @@
 #include "Filters.h"
+#include "Kernels.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <vector>
 #include <stdexcept>
 
 constexpr float KSharpeningCenterWeight = 5.0f;
+constexpr size_t KMatrixSize = 3;
+
+namespace {
+
+Image Convolve3x3(const Image& input, const std::vector<std::vector<float>>& matrix,
+                  const kernels::KernelTable& table) {
+    Image output(input.GetWidth(), input.GetHeight());
+    std::array<float, KMatrixSize * KMatrixSize> weights{};
+    for (size_t row = 0; row < KMatrixSize; ++row) {
+        for (size_t col = 0; col < KMatrixSize; ++col) {
+            weights[row * KMatrixSize + col] = matrix[row][col];
+        }
+    }
+    size_t height = input.GetHeight();
+    for (size_t y = 0; y < height; ++y) {
+        const Pixel* above = input.GetRow(y == 0 ? 0 : y - 1);
+        const Pixel* below = input.GetRow(std::min(y + 1, height - 1));
+        table.convolve3x3_row(above, input.GetRow(y), below, weights.data(), output.GetRow(y), input.GetWidth());
+    }
+    return output;
+}
+
+Region ExpandRegion(const Region& region, size_t margin, size_t width, size_t height) {
+    size_t x = region.x > margin ? region.x - margin : 0;
+    size_t y = region.y > margin ? region.y - margin : 0;
+    size_t right = std::min(width, region.x + region.width + margin);
+    size_t bottom = std::min(height, region.y + region.height + margin);
+    return Region{x, y, right - x, bottom - y};
+}
+
+Region AlignRegion(const Region& region, size_t block_size, size_t width, size_t height) {
+    size_t x = region.x / block_size * block_size;
+    size_t y = region.y / block_size * block_size;
+    size_t right = std::min(width, (region.x + region.width + block_size - 1) / block_size * block_size);
+    size_t bottom = std::min(height, (region.y + region.height + block_size - 1) / block_size * block_size);
+    return Region{x, y, right - x, bottom - y};
+}
+
+}  // namespace
 
 CropFilter::CropFilter(size_t width, size_t height) : width_(width), height_(height) {
 }
 
-Image CropFilter::Apply(const Image& input) const {
+Image CropFilter::Apply(const Image& input, const kernels::KernelTable&) const {
     size_t out_width = std::min(width_, input.GetWidth());
     size_t out_height = std::min(height_, input.GetHeight());
     Image output(out_width, out_height);
@@ -22,19 +63,19 @@ Image CropFilter::Apply(const Image& input) const {
     return output;
 }
 
-Image GrayscaleFilter::Apply(const Image& input) const {
+Image GrayscaleFilter::Apply(const Image& input, const kernels::KernelTable& table) const {
     Image output(input.GetWidth(), input.GetHeight());
     for (size_t y = 0; y < input.GetHeight(); ++y) {
-        for (size_t x = 0; x < input.GetWidth(); ++x) {
-            Pixel p = input.GetPixel(static_cast<int>(x), static_cast<int>(y));
-            float gray = KGrayscaleRedWeight * p.r + KGrayscaleGreenWeight * p.g + KGrayscaleBlueWeight * p.b;
-            output.SetPixel(x, y, Pixel(gray, gray, gray));
-        }
+        table.grayscale_row(input.GetRow(y), output.GetRow(y), input.GetWidth());
     }
     return output;
 }
 
-Image NegativeFilter::Apply(const Image& input) const {
+std::optional<Region> GrayscaleFilter::GetInputRegion(const Region& output, size_t, size_t) const {
+    return output;
+}
+
+Image NegativeFilter::Apply(const Image& input, const kernels::KernelTable&) const {
     Image output(input.GetWidth(), input.GetHeight());
     for (size_t y = 0; y < input.GetHeight(); ++y) {
         for (size_t x = 0; x < input.GetWidth(); ++x) {
@@ -45,76 +86,47 @@ Image NegativeFilter::Apply(const Image& input) const {
     return output;
 }
 
-Image SharpeningFilter::Apply(const Image& input) const {
+std::optional<Region> NegativeFilter::GetInputRegion(const Region& output, size_t, size_t) const {
+    return output;
+}
+
+Image SharpeningFilter::Apply(const Image& input, const kernels::KernelTable& table) const {
     std::vector<std::vector<float>> matrix = {{0, -1, 0}, {-1, KSharpeningCenterWeight, -1}, {0, -1, 0}};
-    return ApplyMatrix(input, matrix);
+    return ApplyMatrix(input, matrix, table);
 }
 
-Image SharpeningFilter::ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix) const {
-    Image output(input.GetWidth(), input.GetHeight());
-    int radius = 1;
-    for (size_t y = 0; y < input.GetHeight(); ++y) {
-        for (size_t x = 0; x < input.GetWidth(); ++x) {
-            float r_sum = 0.0f;
-            float g_sum = 0.0f;
-            float b_sum = 0.0f;
-            for (int dy = -radius; dy <= radius; ++dy) {
-                for (int dx = -radius; dx <= radius; ++dx) {
-                    Pixel p = input.GetPixel(static_cast<int>(x) + dx, static_cast<int>(y) + dy);
-                    float weight = matrix[radius + dy][radius + dx];
-                    r_sum += weight * p.r;
-                    g_sum += weight * p.g;
-                    b_sum += weight * p.b;
-                }
-            }
-            r_sum = std::min(1.0f, std::max(0.0f, r_sum));
-            g_sum = std::min(1.0f, std::max(0.0f, g_sum));
-            b_sum = std::min(1.0f, std::max(0.0f, b_sum));
-            output.SetPixel(x, y, Pixel(r_sum, g_sum, b_sum));
-        }
-    }
-    return output;
+std::optional<Region> SharpeningFilter::GetInputRegion(const Region& output, size_t width, size_t height) const {
+    return ExpandRegion(output, 1, width, height);
+}
+
+Image SharpeningFilter::ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix,
+                                    const kernels::KernelTable& table) const {
+    return Convolve3x3(input, matrix, table);
 }
 
 EdgeDetectionFilter::EdgeDetectionFilter(float threshold) : threshold_(threshold) {
 }
 
-Image EdgeDetectionFilter::Apply(const Image& input) const {
+Image EdgeDetectionFilter::Apply(const Image& input, const kernels::KernelTable& table) const {
     GrayscaleFilter gs;
-    Image gray = gs.Apply(input);
+    Image gray = gs.Apply(input, table);
     std::vector<std::vector<float>> matrix = {{0, -1, 0}, {-1, 4, -1}, {0, -1, 0}};
-    Image output = ApplyMatrix(gray, matrix);
+    Image response = ApplyMatrix(gray, matrix, table);
+    Image output(response.GetWidth(), response.GetHeight());
     for (size_t y = 0; y < output.GetHeight(); ++y) {
-        for (size_t x = 0; x < output.GetWidth(); ++x) {
-            Pixel p = output.GetPixel(static_cast<int>(x), static_cast<int>(y));
-            if (p.r > threshold_) {
-                output.SetPixel(x, y, Pixel(1, 1, 1));
-            } else {
-                output.SetPixel(x, y, Pixel(0, 0, 0));
-            }
-        }
+        table.threshold_row(response.GetRow(y), threshold_, output.GetRow(y), output.GetWidth());
     }
     return output;
 }
 
-Image EdgeDetectionFilter::ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix) const {
-    Image output(input.GetWidth(), input.GetHeight());
-    int radius = 1;
-    for (size_t y = 0; y < input.GetHeight(); ++y) {
-        for (size_t x = 0; x < input.GetWidth(); ++x) {
-            float sum = 0.0f;
-            for (int dy = -radius; dy <= radius; ++dy) {
-                for (int dx = -radius; dx <= radius; ++dx) {
-                    Pixel p = input.GetPixel(static_cast<int>(x) + dx, static_cast<int>(y) + dy);
-                    float weight = matrix[radius + dy][radius + dx];
-                    sum += weight * p.r;
-                }
-            }
-            sum = std::min(1.0f, std::max(0.0f, sum));
-            output.SetPixel(x, y, Pixel(sum, sum, sum));
-        }
-    }
-    return output;
+std::optional<Region> EdgeDetectionFilter::GetInputRegion(const Region& output, size_t width,
+                                                           size_t height) const {
+    return ExpandRegion(output, 1, width, height);
+}
+
+Image EdgeDetectionFilter::ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix,
+                                       const kernels::KernelTable& table) const {
+    return Convolve3x3(input, matrix, table);
 }
 
 GaussianBlurFilter::GaussianBlurFilter(float sigma) : sigma_(sigma) {
@@ -123,8 +135,12 @@ GaussianBlurFilter::GaussianBlurFilter(float sigma) : sigma_(sigma) {
     }
 }
 
-Image GaussianBlurFilter::Apply(const Image& input) const {
-    int radius = static_cast<int>(std::ceil(3 * sigma_));
+int GaussianBlurFilter::GetRadius() const {
+    return static_cast<int>(std::ceil(3 * sigma_));
+}
+
+Image GaussianBlurFilter::Apply(const Image& input, const kernels::KernelTable& table) const {
+    int radius = GetRadius();
     std::vector<float> kernel(2 * radius + 1);
     float sum = 0.0f;
     for (int i = -radius; i <= radius; ++i) {
@@ -134,47 +150,34 @@ Image GaussianBlurFilter::Apply(const Image& input) const {
     for (auto& val : kernel) {
         val /= sum;
     }
-    Image temp = ApplyKernelHorizontal(input, kernel, radius);
-    return ApplyKernelVertical(temp, kernel, radius);
+    Image temp = ApplyKernelHorizontal(input, kernel, radius, table);
+    return ApplyKernelVertical(temp, kernel, radius, table);
+}
+
+std::optional<Region> GaussianBlurFilter::GetInputRegion(const Region& output, size_t width, size_t height) const {
+    return ExpandRegion(output, static_cast<size_t>(GetRadius()), width, height);
 }
 
-Image GaussianBlurFilter::ApplyKernelHorizontal(const Image& input, const std::vector<float>& kernel,
-                                                int radius) const {
+Image GaussianBlurFilter::ApplyKernelHorizontal(const Image& input, const std::vector<float>& kernel, int radius,
+                                                const kernels::KernelTable& table) const {
     Image output(input.GetWidth(), input.GetHeight());
     for (size_t y = 0; y < input.GetHeight(); ++y) {
-        for (size_t x = 0; x < input.GetWidth(); ++x) {
-            float r_sum = 0.0f;
-            float g_sum = 0.0f;
-            float b_sum = 0.0f;
-            for (int dx = -radius; dx <= radius; ++dx) {
-                Pixel p = input.GetPixel(static_cast<int>(x) + dx, static_cast<int>(y));
-                float weight = kernel[radius + dx];
-                r_sum += weight * p.r;
-                g_sum += weight * p.g;
-                b_sum += weight * p.b;
-            }
-            output.SetPixel(x, y, Pixel(r_sum, g_sum, b_sum));
-        }
+        table.blur_horizontal_row(input.GetRow(y), kernel.data(), radius, output.GetRow(y), input.GetWidth());
     }
     return output;
 }
 
-Image GaussianBlurFilter::ApplyKernelVertical(const Image& input, const std::vector<float>& kernel, int radius) const {
+Image GaussianBlurFilter::ApplyKernelVertical(const Image& input, const std::vector<float>& kernel, int radius,
+                                              const kernels::KernelTable& table) const {
     Image output(input.GetWidth(), input.GetHeight());
-    for (size_t x = 0; x < input.GetWidth(); ++x) {
-        for (size_t y = 0; y < input.GetHeight(); ++y) {
-            float r_sum = 0.0f;
-            float g_sum = 0.0f;
-            float b_sum = 0.0f;
-            for (int dy = -radius; dy <= radius; ++dy) {
-                Pixel p = input.GetPixel(static_cast<int>(x), static_cast<int>(y) + dy);
-                float weight = kernel[radius + dy];
-                r_sum += weight * p.r;
-                g_sum += weight * p.g;
-                b_sum += weight * p.b;
-            }
-            output.SetPixel(x, y, Pixel(r_sum, g_sum, b_sum));
+    int last_row = static_cast<int>(input.GetHeight()) - 1;
+    std::vector<const Pixel*> rows(kernel.size());
+    for (size_t y = 0; y < input.GetHeight(); ++y) {
+        for (int dy = -radius; dy <= radius; ++dy) {
+            int source_row = std::max(0, std::min(last_row, static_cast<int>(y) + dy));
+            rows[radius + dy] = input.GetRow(static_cast<size_t>(source_row));
         }
+        table.blur_vertical_row(rows.data(), kernel.data(), radius, output.GetRow(y), input.GetWidth());
     }
     return output;
 }
@@ -185,7 +188,7 @@ PixelateFilter::PixelateFilter(size_t block_size) : block_size_(block_size) {
     }
 }
 
-Image PixelateFilter::Apply(const Image& input) const {
+Image PixelateFilter::Apply(const Image& input, const kernels::KernelTable&) const {
     Image output(input.GetWidth(), input.GetHeight());
     for (size_t y_start = 0; y_start < input.GetHeight(); y_start += block_size_) {
         for (size_t x_start = 0; x_start < input.GetWidth(); x_start += block_size_) {
@@ -214,4 +217,8 @@ Image PixelateFilter::Apply(const Image& input) const {
         }
     }
     return output;
+}
+
+std::optional<Region> PixelateFilter::GetInputRegion(const Region& output, size_t width, size_t height) const {
+    return AlignRegion(output, block_size_, width, height);
 }
\ No newline at end of file
@@ -11,7 +11,8 @@ constexpr float KGrayscaleBlueWeight = 0.114f;
 class CropFilter : public Filter {
 public:
     CropFilter(size_t width, size_t height);
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
 
 private:
     size_t width_, height_;
@@ -19,47 +20,64 @@ private:
 
 class GrayscaleFilter : public Filter {
 public:
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 };
 
 class NegativeFilter : public Filter {
 public:
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 };
 
 class SharpeningFilter : public Filter {
 public:
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 
 private:
-    Image ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix) const;
+    Image ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix,
+                      const kernels::KernelTable& table) const;
 };
 
 class EdgeDetectionFilter : public Filter {
 public:
     explicit EdgeDetectionFilter(float threshold);
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 
 private:
     float threshold_;
-    Image ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix) const;
+    Image ApplyMatrix(const Image& input, const std::vector<std::vector<float>>& matrix,
+                      const kernels::KernelTable& table) const;
 };
 
 class GaussianBlurFilter : public Filter {
 public:
     explicit GaussianBlurFilter(float sigma);
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 
 private:
     float sigma_;
-    Image ApplyKernelHorizontal(const Image& input, const std::vector<float>& kernel, int radius) const;
-    Image ApplyKernelVertical(const Image& input, const std::vector<float>& kernel, int radius) const;
+    int GetRadius() const;
+    Image ApplyKernelHorizontal(const Image& input, const std::vector<float>& kernel, int radius,
+                                const kernels::KernelTable& table) const;
+    Image ApplyKernelVertical(const Image& input, const std::vector<float>& kernel, int radius,
+                              const kernels::KernelTable& table) const;
 };
 
 class PixelateFilter : public Filter {
 public:
     explicit PixelateFilter(size_t block_size);
-    Image Apply(const Image& input) const override;
+    using Filter::Apply;
+    Image Apply(const Image& input, const kernels::KernelTable& table) const override;
+    std::optional<Region> GetInputRegion(const Region& output, size_t width, size_t height) const override;
 
 private:
     size_t block_size_;
@@ -1,7 +1,63 @@
 #include "Image.h"
 #include <algorithm>
+#include <stdexcept>
 
-Image::Image(size_t width, size_t height) : width_(width), height_(height), pixels_(width * height) {
+bool Region::operator==(const Region& other) const {
+    return x == other.x && y == other.y && width == other.width && height == other.height;
+}
+
+Image::Image(size_t width, size_t height)
+    : width_(width),
+      height_(height),
+      pixels_(width * height),
+      data_(pixels_.data()),
+      stride_(static_cast<std::ptrdiff_t>(width)) {
+}
+
+Image::Image(Pixel* data, size_t width, size_t height, std::ptrdiff_t stride)
+    : width_(width), height_(height), data_(data), stride_(stride) {
+}
+
+Image::Image(const Image& other) : Image(other.width_, other.height_) {
+    for (size_t y = 0; y < height_; ++y) {
+        std::copy(other.GetRow(y), other.GetRow(y) + width_, GetRow(y));
+    }
+}
+
+Image::Image(Image&& other) noexcept
+    : width_(other.width_),
+      height_(other.height_),
+      pixels_(std::move(other.pixels_)),
+      data_(other.data_),
+      stride_(other.stride_) {
+    other.width_ = 0;
+    other.height_ = 0;
+    other.pixels_.clear();
+    other.data_ = other.pixels_.data();
+    other.stride_ = 0;
+}
+
+Image& Image::operator=(const Image& other) {
+    if (this != &other) {
+        *this = Image(other);
+    }
+    return *this;
+}
+
+Image& Image::operator=(Image&& other) noexcept {
+    if (this != &other) {
+        width_ = other.width_;
+        height_ = other.height_;
+        pixels_ = std::move(other.pixels_);
+        data_ = other.data_;
+        stride_ = other.stride_;
+        other.width_ = 0;
+        other.height_ = 0;
+        other.pixels_.clear();
+        other.data_ = other.pixels_.data();
+        other.stride_ = 0;
+    }
+    return *this;
 }
 
 size_t Image::GetWidth() const {
@@ -15,11 +71,45 @@ size_t Image::GetHeight() const {
 Pixel Image::GetPixel(int x, int y) const {
     x = std::max(0, std::min(static_cast<int>(width_) - 1, x));
     y = std::max(0, std::min(static_cast<int>(height_) - 1, y));
-    return pixels_[y * width_ + x];
+    return GetRow(static_cast<size_t>(y))[x];
 }
 
 void Image::SetPixel(size_t x, size_t y, const Pixel& pixel) {
     if (x < width_ && y < height_) {
-        pixels_[y * width_ + x] = pixel;
+        GetRow(y)[x] = pixel;
+    }
+}
+
+const Pixel* Image::GetRow(size_t y) const {
+    return data_ + static_cast<std::ptrdiff_t>(y) * stride_;
+}
+
+Pixel* Image::GetRow(size_t y) {
+    return data_ + static_cast<std::ptrdiff_t>(y) * stride_;
+}
+
+Image Image::CopyRegion(const Region& region) const {
+    if (region.x + region.width > width_ || region.y + region.height > height_) {
+        throw std::out_of_range("Region is outside of the image");
+    }
+    Image output(region.width, region.height);
+    for (size_t y = 0; y < region.height; ++y) {
+        const Pixel* row = GetRow(region.y + y) + region.x;
+        std::copy(row, row + region.width, output.GetRow(y));
+    }
+    return output;
+}
+
+void Image::PasteRegion(const Image& source, const Region& source_region, size_t x, size_t y) {
+    if (source_region.x + source_region.width > source.width_ ||
+        source_region.y + source_region.height > source.height_) {
+        throw std::out_of_range("Region is outside of the source image");
+    }
+    if (x + source_region.width > width_ || y + source_region.height > height_) {
+        throw std::out_of_range("Region does not fit into the image");
+    }
+    for (size_t row = 0; row < source_region.height; ++row) {
+        const Pixel* source_row = source.GetRow(source_region.y + row) + source_region.x;
+        std::copy(source_row, source_row + source_region.width, GetRow(y + row) + x);
     }
 }
\ No newline at end of file
@@ -1,19 +1,43 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 #include "Pixel.h"
 
+struct Region {
+    size_t x = 0;
+    size_t y = 0;
+    size_t width = 0;
+    size_t height = 0;
+
+    bool operator==(const Region& other) const;
+};
+
 class Image {
 public:
     Image(size_t width, size_t height);
+    // Wraps caller-owned pixels without copying them. `stride` is the distance between rows in
+    // pixels and may be negative. The memory must outlive the image; copies always own their pixels.
+    Image(Pixel* data, size_t width, size_t height, std::ptrdiff_t stride);
+    Image(const Image& other);
+    Image(Image&& other) noexcept;
+    Image& operator=(const Image& other);
+    Image& operator=(Image&& other) noexcept;
 
     size_t GetWidth() const;
     size_t GetHeight() const;
     Pixel GetPixel(int x, int y) const;
     void SetPixel(size_t x, size_t y, const Pixel& p);
+    const Pixel* GetRow(size_t y) const;
+    Pixel* GetRow(size_t y);
+
+    Image CopyRegion(const Region& region) const;
+    void PasteRegion(const Image& source, const Region& source_region, size_t x, size_t y);
 
 private:
     size_t width_;
     size_t height_;
     std::vector<Pixel> pixels_;
+    Pixel* data_;
+    std::ptrdiff_t stride_;
 };
\ No newline at end of file
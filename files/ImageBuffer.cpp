@@ -0,0 +1,71 @@
+#include "ImageBuffer.h"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+void ValidateBuffer(const ImageBuffer& buffer) {
+    if (buffer.width == 0 || buffer.height == 0) {
+        return;
+    }
+    if (buffer.data == nullptr) {
+        throw std::invalid_argument("Image buffer has no data");
+    }
+    size_t row_size = buffer.width * GetBytesPerPixel(buffer.format);
+    if (static_cast<size_t>(std::abs(buffer.stride)) < row_size && buffer.height > 1) {
+        throw std::invalid_argument("Image buffer stride is smaller than a row");
+    }
+}
+
+// A float buffer can be used as Image rows only if every row starts on a whole, aligned pixel.
+bool IsPixelAligned(const ImageBuffer& buffer) {
+    return buffer.stride % static_cast<std::ptrdiff_t>(sizeof(Pixel)) == 0 &&
+           reinterpret_cast<uintptr_t>(buffer.data) % alignof(Pixel) == 0;
+}
+
+uint8_t* GetBufferRow(const ImageBuffer& buffer, size_t y) {
+    return static_cast<uint8_t*>(buffer.data) + static_cast<std::ptrdiff_t>(y) * buffer.stride;
+}
+
+}  // namespace
+
+size_t GetBytesPerPixel(PixelFormat format) {
+    return format == PixelFormat::Bgr8 ? 3 : sizeof(Pixel);
+}
+
+Image ImportImage(const ImageBuffer& buffer, const kernels::KernelTable& table) {
+    ValidateBuffer(buffer);
+    if (buffer.format == PixelFormat::RgbFloat && IsPixelAligned(buffer)) {
+        return Image(static_cast<Pixel*>(buffer.data), buffer.width, buffer.height,
+                     buffer.stride / static_cast<std::ptrdiff_t>(sizeof(Pixel)));
+    }
+    Image image(buffer.width, buffer.height);
+    for (size_t y = 0; y < buffer.height; ++y) {
+        if (buffer.format == PixelFormat::RgbFloat) {
+            std::memcpy(image.GetRow(y), GetBufferRow(buffer, y), buffer.width * sizeof(Pixel));
+        } else {
+            table.decode_bgr_row(GetBufferRow(buffer, y), image.GetRow(y), buffer.width);
+        }
+    }
+    return image;
+}
+
+void ExportImage(const Image& image, const ImageBuffer& buffer, const kernels::KernelTable& table) {
+    ValidateBuffer(buffer);
+    if (image.GetWidth() != buffer.width || image.GetHeight() != buffer.height) {
+        throw std::invalid_argument("Image buffer size does not match the image");
+    }
+    for (size_t y = 0; y < buffer.height; ++y) {
+        const Pixel* row = image.GetRow(y);
+        uint8_t* destination = GetBufferRow(buffer, y);
+        if (buffer.format == PixelFormat::RgbFloat) {
+            if (reinterpret_cast<const uint8_t*>(row) != destination) {
+                std::memcpy(destination, row, buffer.width * sizeof(Pixel));
+            }
+        } else {
+            table.encode_bgr_row(row, destination, buffer.width);
+        }
+    }
+}
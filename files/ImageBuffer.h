@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Image.h"
+#include "Kernels.h"
+#include <cstddef>
+
+enum class PixelFormat { Bgr8, RgbFloat };
+
+// Pixels owned by the caller. Rows are in the same bottom-up order as Image and BMP files;
+// a top-down buffer can be passed as a pointer to its last row with a negative stride.
+struct ImageBuffer {
+    void* data = nullptr;
+    size_t width = 0;
+    size_t height = 0;
+    // Bytes between the starts of consecutive rows.
+    std::ptrdiff_t stride = 0;
+    PixelFormat format = PixelFormat::RgbFloat;
+};
+
+size_t GetBytesPerPixel(PixelFormat format);
+
+// RgbFloat buffers whose stride is a whole number of pixels are wrapped without copying, so the
+// image refers to buffer.data; other float strides are copied and Bgr8 buffers are converted.
+Image ImportImage(const ImageBuffer& buffer, const kernels::KernelTable& table = kernels::GetKernels());
+// Writes the image into a buffer of the same size, converting to its format.
+void ExportImage(const Image& image, const ImageBuffer& buffer,
+                 const kernels::KernelTable& table = kernels::GetKernels());
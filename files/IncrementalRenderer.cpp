@@ -0,0 +1,125 @@
+#include "IncrementalRenderer.h"
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+bool SameSize(const Image& first, const Image& second) {
+    return first.GetWidth() == second.GetWidth() && first.GetHeight() == second.GetHeight();
+}
+
+std::optional<Region> FindChangedRegion(const Image& previous, const Image& current) {
+    size_t width = current.GetWidth();
+    size_t left = width;
+    size_t right = 0;
+    size_t top = current.GetHeight();
+    size_t bottom = 0;
+    for (size_t y = 0; y < current.GetHeight(); ++y) {
+        const Pixel* previous_row = previous.GetRow(y);
+        const Pixel* current_row = current.GetRow(y);
+        auto mismatch = std::mismatch(current_row, current_row + width, previous_row);
+        if (mismatch.first == current_row + width) {
+            continue;
+        }
+        size_t first = static_cast<size_t>(mismatch.first - current_row);
+        size_t last = width - 1;
+        while (current_row[last] == previous_row[last]) {
+            --last;
+        }
+        left = std::min(left, first);
+        right = std::max(right, last + 1);
+        top = std::min(top, y);
+        bottom = y + 1;
+    }
+    if (left >= right) {
+        return std::nullopt;
+    }
+    return Region{left, top, right - left, bottom - top};
+}
+
+Region ClipRegion(const Region& region, size_t width, size_t height) {
+    size_t x = std::min(region.x, width);
+    size_t y = std::min(region.y, height);
+    return Region{x, y, std::min(region.width, width - x), std::min(region.height, height - y)};
+}
+
+size_t GetArea(const Image& image) {
+    return image.GetWidth() * image.GetHeight();
+}
+
+}  // namespace
+
+IncrementalRenderer::IncrementalRenderer(std::vector<std::unique_ptr<Filter>> filters)
+    : filters_(std::move(filters)) {
+}
+
+const Image& IncrementalRenderer::Render(const Image& input) {
+    stages_.assign(1, input);
+    stages_.reserve(filters_.size() + 1);
+    recomputed_pixels_ = 0;
+    RenderFrom(0);
+    return GetOutput();
+}
+
+const Image& IncrementalRenderer::Update(const Image& input) {
+    if (stages_.empty() || !SameSize(stages_[0], input)) {
+        return Render(input);
+    }
+    std::optional<Region> changed = FindChangedRegion(stages_[0], input);
+    if (!changed) {
+        recomputed_pixels_ = 0;
+        return GetOutput();
+    }
+    return Update(input, *changed);
+}
+
+const Image& IncrementalRenderer::Update(const Image& input, const Region& changed) {
+    if (stages_.empty() || !SameSize(stages_[0], input)) {
+        return Render(input);
+    }
+    recomputed_pixels_ = 0;
+    Region dirty = ClipRegion(changed, input.GetWidth(), input.GetHeight());
+    if (dirty.width == 0 || dirty.height == 0) {
+        return GetOutput();
+    }
+    stages_[0].PasteRegion(input, dirty, dirty.x, dirty.y);
+    for (size_t stage = 0; stage < filters_.size(); ++stage) {
+        const Image& source = stages_[stage];
+        size_t width = source.GetWidth();
+        size_t height = source.GetHeight();
+        // Footprints are symmetric, so the outputs that read a changed pixel are exactly
+        // the input region of the changed area.
+        std::optional<Region> output = filters_[stage]->GetInputRegion(dirty, width, height);
+        if (!output) {
+            RenderFrom(stage);
+            return GetOutput();
+        }
+        Region input_region = *filters_[stage]->GetInputRegion(*output, width, height);
+        Image patch = filters_[stage]->Apply(source.CopyRegion(input_region));
+        Region patch_region{output->x - input_region.x, output->y - input_region.y, output->width, output->height};
+        stages_[stage + 1].PasteRegion(patch, patch_region, output->x, output->y);
+        recomputed_pixels_ += GetArea(patch);
+        dirty = *output;
+    }
+    return GetOutput();
+}
+
+const Image& IncrementalRenderer::GetOutput() const {
+    if (stages_.empty()) {
+        throw std::logic_error("IncrementalRenderer has not rendered anything yet");
+    }
+    return stages_.back();
+}
+
+size_t IncrementalRenderer::GetRecomputedPixels() const {
+    return recomputed_pixels_;
+}
+
+void IncrementalRenderer::RenderFrom(size_t stage) {
+    stages_.resize(stage + 1, Image(0, 0));
+    for (; stage < filters_.size(); ++stage) {
+        stages_.push_back(filters_[stage]->Apply(stages_[stage]));
+        recomputed_pixels_ += GetArea(stages_.back());
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Filter.h"
+#include <memory>
+#include <vector>
+
+// Keeps the input and every intermediate result of a filter chain, so that after a small
+// edit only the pixels affected by it are recomputed. The changed area is grown by each
+// filter's footprint (GetInputRegion) on its way down the chain; a filter without a
+// footprint, such as crop, makes the rest of the chain run on the whole image.
+class IncrementalRenderer {
+public:
+    explicit IncrementalRenderer(std::vector<std::unique_ptr<Filter>> filters);
+
+    // Runs the whole chain and caches all stages.
+    const Image& Render(const Image& input);
+    // Finds the changed pixels by comparing with the cached input.
+    const Image& Update(const Image& input);
+    // Trusts `changed` to contain every pixel of `input` that differs from the cached input.
+    const Image& Update(const Image& input, const Region& changed);
+
+    const Image& GetOutput() const;
+    // Output pixels written by filters during the last Render or Update, over all stages.
+    size_t GetRecomputedPixels() const;
+
+private:
+    void RenderFrom(size_t stage);
+
+    std::vector<std::unique_ptr<Filter>> filters_;
+    // stages_[0] is the input, stages_[i + 1] the output of filters_[i].
+    std::vector<Image> stages_;
+    size_t recomputed_pixels_ = 0;
+};
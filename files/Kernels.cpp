@@ -0,0 +1,83 @@
+#define KERNELS_ISA scalar
+#include "KernelsImpl.h"
+
+#include <stdexcept>
+
+namespace kernels {
+
+#ifdef IMAGE_PROCESSOR_X86_KERNELS
+namespace sse4 {
+const KernelTable& Table();
+}
+namespace avx2 {
+const KernelTable& Table();
+}
+namespace avx512 {
+const KernelTable& Table();
+}
+#endif
+
+SimdLevel DetectSimdLevel() {
+#ifdef IMAGE_PROCESSOR_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::Sse4;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+bool IsSimdLevelSupported(SimdLevel level) {
+    return static_cast<int>(level) <= static_cast<int>(DetectSimdLevel());
+}
+
+SimdLevel ParseSimdLevel(const std::string& name) {
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse4, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (name == SimdLevelName(level)) {
+            return level;
+        }
+    }
+    throw std::runtime_error("Unknown SIMD level: " + name);
+}
+
+const char* SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::Sse4:
+            return "sse4";
+        case SimdLevel::Avx2:
+            return "avx2";
+        case SimdLevel::Avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+const KernelTable& GetKernels() {
+    static const KernelTable& table = GetKernels(DetectSimdLevel());
+    return table;
+}
+
+const KernelTable& GetKernels(SimdLevel level) {
+    switch (level) {
+#ifdef IMAGE_PROCESSOR_X86_KERNELS
+        case SimdLevel::Sse4:
+            return sse4::Table();
+        case SimdLevel::Avx2:
+            return avx2::Table();
+        case SimdLevel::Avx512:
+            return avx512::Table();
+#endif
+        default:
+            return scalar::Table();
+    }
+}
+
+}  // namespace kernels
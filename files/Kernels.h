@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Pixel.h"
+
+namespace kernels {
+
+enum class SimdLevel { Scalar, Sse4, Avx2, Avx512 };
+
+// Row kernels used by the hot loops of BMP.cpp and Filters.cpp. Every variant
+// produces the same floats as the scalar one: per-pixel summation order is kept
+// and floating-point contraction is disabled for all kernel translation units.
+struct KernelTable {
+    void (*decode_bgr_row)(const uint8_t* src, Pixel* dst, size_t width);
+    void (*encode_bgr_row)(const Pixel* src, uint8_t* dst, size_t width);
+    void (*grayscale_row)(const Pixel* src, Pixel* dst, size_t width);
+    void (*convolve3x3_row)(const Pixel* above, const Pixel* row, const Pixel* below, const float* matrix,
+                            Pixel* dst, size_t width);
+    void (*threshold_row)(const Pixel* src, float threshold, Pixel* dst, size_t width);
+    void (*blur_horizontal_row)(const Pixel* src, const float* kernel, int radius, Pixel* dst, size_t width);
+    void (*blur_vertical_row)(const Pixel* const* rows, const float* kernel, int radius, Pixel* dst, size_t width);
+};
+
+SimdLevel DetectSimdLevel();
+bool IsSimdLevelSupported(SimdLevel level);
+
+SimdLevel ParseSimdLevel(const std::string& name);
+const char* SimdLevelName(SimdLevel level);
+
+// Kernels for the best level supported by the CPU, detected once. Callers that force a level
+// pass GetKernels(level) down explicitly instead of changing this default.
+const KernelTable& GetKernels();
+const KernelTable& GetKernels(SimdLevel level);
+
+}  // namespace kernels
@@ -0,0 +1,196 @@
+// Generic bodies of the row kernels. This header is included once per
+// instruction set; the including translation unit defines KERNELS_ISA to the
+// namespace that receives its copy and is compiled with the matching flags.
+
+#ifndef KERNELS_ISA
+#error "KERNELS_ISA must be defined before including KernelsImpl.h"
+#endif
+
+#include "Filters.h"
+#include "Kernels.h"
+#include <algorithm>
+
+static_assert(sizeof(Pixel) == 3 * sizeof(float), "Pixel rows are processed as packed float triples");
+
+namespace kernels::KERNELS_ISA {
+namespace {
+
+constexpr size_t KChannels = 3;
+constexpr float KMaxColorValue = 255.0f;
+
+const float* Floats(const Pixel* pixels) {
+    return reinterpret_cast<const float*>(pixels);
+}
+
+float* Floats(Pixel* pixels) {
+    return reinterpret_cast<float*>(pixels);
+}
+
+size_t Clamp(int value, size_t size) {
+    return static_cast<size_t>(std::max(0, std::min(static_cast<int>(size) - 1, value)));
+}
+
+void DecodeBgrRow(const uint8_t* __restrict src, Pixel* dst, size_t width) {
+    float* __restrict out = Floats(dst);
+    for (size_t i = 0; i < width * KChannels; i += KChannels) {
+        out[i] = static_cast<float>(src[i + 2]) / KMaxColorValue;
+        out[i + 1] = static_cast<float>(src[i + 1]) / KMaxColorValue;
+        out[i + 2] = static_cast<float>(src[i]) / KMaxColorValue;
+    }
+}
+
+void EncodeBgrRow(const Pixel* src, uint8_t* __restrict dst, size_t width) {
+    const float* __restrict in = Floats(src);
+    for (size_t i = 0; i < width * KChannels; i += KChannels) {
+        dst[i] = static_cast<uint8_t>(std::clamp(in[i + 2] * KMaxColorValue, 0.0f, KMaxColorValue));
+        dst[i + 1] = static_cast<uint8_t>(std::clamp(in[i + 1] * KMaxColorValue, 0.0f, KMaxColorValue));
+        dst[i + 2] = static_cast<uint8_t>(std::clamp(in[i] * KMaxColorValue, 0.0f, KMaxColorValue));
+    }
+}
+
+void GrayscaleRow(const Pixel* src, Pixel* dst, size_t width) {
+    const float* __restrict in = Floats(src);
+    float* __restrict out = Floats(dst);
+    for (size_t i = 0; i < width * KChannels; i += KChannels) {
+        float gray = KGrayscaleRedWeight * in[i] + KGrayscaleGreenWeight * in[i + 1] + KGrayscaleBlueWeight * in[i + 2];
+        out[i] = gray;
+        out[i + 1] = gray;
+        out[i + 2] = gray;
+    }
+}
+
+void ConvolvePixel(const float* above, const float* row, const float* below, const float* matrix, float* out,
+                   size_t width, size_t x) {
+    size_t left = Clamp(static_cast<int>(x) - 1, width) * KChannels;
+    size_t center = x * KChannels;
+    size_t right = Clamp(static_cast<int>(x) + 1, width) * KChannels;
+    for (size_t c = 0; c < KChannels; ++c) {
+        float sum = 0.0f;
+        sum += matrix[0] * above[left + c];
+        sum += matrix[1] * above[center + c];
+        sum += matrix[2] * above[right + c];
+        sum += matrix[3] * row[left + c];
+        sum += matrix[4] * row[center + c];
+        sum += matrix[5] * row[right + c];
+        sum += matrix[6] * below[left + c];
+        sum += matrix[7] * below[center + c];
+        sum += matrix[8] * below[right + c];
+        out[center + c] = std::min(1.0f, std::max(0.0f, sum));
+    }
+}
+
+void Convolve3x3Row(const Pixel* above_row, const Pixel* center_row, const Pixel* below_row, const float* matrix,
+                    Pixel* dst, size_t width) {
+    const float* above = Floats(above_row);
+    const float* row = Floats(center_row);
+    const float* below = Floats(below_row);
+    float* __restrict out = Floats(dst);
+    if (width == 0) {
+        return;
+    }
+    ConvolvePixel(above, row, below, matrix, out, width, 0);
+    if (width == 1) {
+        return;
+    }
+    const float m0 = matrix[0];
+    const float m1 = matrix[1];
+    const float m2 = matrix[2];
+    const float m3 = matrix[3];
+    const float m4 = matrix[4];
+    const float m5 = matrix[5];
+    const float m6 = matrix[6];
+    const float m7 = matrix[7];
+    const float m8 = matrix[8];
+    for (size_t i = KChannels; i < (width - 1) * KChannels; ++i) {
+        float sum = 0.0f;
+        sum += m0 * above[i - KChannels];
+        sum += m1 * above[i];
+        sum += m2 * above[i + KChannels];
+        sum += m3 * row[i - KChannels];
+        sum += m4 * row[i];
+        sum += m5 * row[i + KChannels];
+        sum += m6 * below[i - KChannels];
+        sum += m7 * below[i];
+        sum += m8 * below[i + KChannels];
+        out[i] = std::min(1.0f, std::max(0.0f, sum));
+    }
+    ConvolvePixel(above, row, below, matrix, out, width, width - 1);
+}
+
+void ThresholdRow(const Pixel* src, float threshold, Pixel* dst, size_t width) {
+    const float* __restrict in = Floats(src);
+    float* __restrict out = Floats(dst);
+    for (size_t i = 0; i < width * KChannels; i += KChannels) {
+        float value = in[i] > threshold ? 1.0f : 0.0f;
+        out[i] = value;
+        out[i + 1] = value;
+        out[i + 2] = value;
+    }
+}
+
+void BlurPixel(const float* in, const float* kernel, int radius, float* out, size_t width, size_t x) {
+    float r_sum = 0.0f;
+    float g_sum = 0.0f;
+    float b_sum = 0.0f;
+    for (int dx = -radius; dx <= radius; ++dx) {
+        size_t offset = Clamp(static_cast<int>(x) + dx, width) * KChannels;
+        float weight = kernel[radius + dx];
+        r_sum += weight * in[offset];
+        g_sum += weight * in[offset + 1];
+        b_sum += weight * in[offset + 2];
+    }
+    out[x * KChannels] = r_sum;
+    out[x * KChannels + 1] = g_sum;
+    out[x * KChannels + 2] = b_sum;
+}
+
+void BlurHorizontalRow(const Pixel* src, const float* kernel, int radius, Pixel* dst, size_t width) {
+    const float* in = Floats(src);
+    float* out = Floats(dst);
+    size_t border = static_cast<size_t>(radius);
+    if (width <= 2 * border) {
+        for (size_t x = 0; x < width; ++x) {
+            BlurPixel(in, kernel, radius, out, width, x);
+        }
+        return;
+    }
+    for (size_t x = 0; x < border; ++x) {
+        BlurPixel(in, kernel, radius, out, width, x);
+    }
+    float* __restrict interior = out + border * KChannels;
+    size_t count = (width - 2 * border) * KChannels;
+    std::fill(interior, interior + count, 0.0f);
+    for (int k = 0; k <= 2 * radius; ++k) {
+        const float weight = kernel[k];
+        const float* __restrict tap = in + static_cast<size_t>(k) * KChannels;
+        for (size_t i = 0; i < count; ++i) {
+            interior[i] += weight * tap[i];
+        }
+    }
+    for (size_t x = width - border; x < width; ++x) {
+        BlurPixel(in, kernel, radius, out, width, x);
+    }
+}
+
+void BlurVerticalRow(const Pixel* const* rows, const float* kernel, int radius, Pixel* dst, size_t width) {
+    float* __restrict out = Floats(dst);
+    size_t count = width * KChannels;
+    std::fill(out, out + count, 0.0f);
+    for (int k = 0; k <= 2 * radius; ++k) {
+        const float weight = kernel[k];
+        const float* __restrict tap = Floats(rows[k]);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] += weight * tap[i];
+        }
+    }
+}
+
+}  // namespace
+
+const KernelTable& Table() {
+    static const KernelTable table = {DecodeBgrRow, EncodeBgrRow,      GrayscaleRow,   Convolve3x3Row,
+                                      ThresholdRow, BlurHorizontalRow, BlurVerticalRow};
+    return table;
+}
+
+}  // namespace kernels::KERNELS_ISA
@@ -0,0 +1,2 @@
+#define KERNELS_ISA sse4
+#include "KernelsImpl.h"
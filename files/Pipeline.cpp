@@ -0,0 +1,50 @@
+#include "Pipeline.h"
+#include "TileScheduler.h"
+#include <stdexcept>
+#include <string>
+
+Pipeline& Pipeline::AddFilter(std::unique_ptr<Filter> filter) {
+    filters_.push_back(std::move(filter));
+    return *this;
+}
+
+Pipeline& Pipeline::SetTiled(bool tiled) {
+    tiled_ = tiled;
+    return *this;
+}
+
+Pipeline& Pipeline::SetSimdLevel(kernels::SimdLevel level) {
+    if (!kernels::IsSimdLevelSupported(level)) {
+        throw std::runtime_error(std::string("SIMD level not supported by this CPU: ") +
+                                 kernels::SimdLevelName(level));
+    }
+    kernels_ = &kernels::GetKernels(level);
+    return *this;
+}
+
+const kernels::KernelTable& Pipeline::GetKernels() const {
+    return *kernels_;
+}
+
+Image Pipeline::Process(Image image) const {
+    if (tiled_) {
+        return TileScheduler().Run(filters_, std::move(image), *kernels_);
+    }
+    for (const auto& filter : filters_) {
+        image = filter->Apply(image, *kernels_);
+    }
+    return image;
+}
+
+Image Pipeline::Process(const ImageBuffer& input) const {
+    Image image = ImportImage(input, *kernels_);
+    if (filters_.empty()) {
+        // Every filter allocates its output, so only an empty chain could hand back a view of the caller's buffer.
+        return Image(image);
+    }
+    return Process(std::move(image));
+}
+
+void Pipeline::Process(const ImageBuffer& input, const ImageBuffer& output) const {
+    ExportImage(Process(ImportImage(input, *kernels_)), output, *kernels_);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Filter.h"
+#include "ImageBuffer.h"
+#include <memory>
+#include <vector>
+
+// Entry point for using the filters as a library: a filter chain applied to images or to
+// caller-owned buffers, without going through BMP files.
+class Pipeline {
+public:
+    Pipeline& AddFilter(std::unique_ptr<Filter> filter);
+    // Runs the chain through TileScheduler instead of one filter at a time.
+    Pipeline& SetTiled(bool tiled);
+    // Forces a kernel variant for this pipeline only; other pipelines keep the detected default.
+    // Throws std::runtime_error if the CPU does not support the level.
+    Pipeline& SetSimdLevel(kernels::SimdLevel level);
+    const kernels::KernelTable& GetKernels() const;
+
+    Image Process(Image image) const;
+    // The result always owns its pixels, even when the input buffer was imported without copying.
+    Image Process(const ImageBuffer& input) const;
+    // The output buffer must already have the size of the result.
+    void Process(const ImageBuffer& input, const ImageBuffer& output) const;
+
+private:
+    std::vector<std::unique_ptr<Filter>> filters_;
+    bool tiled_ = false;
+    const kernels::KernelTable* kernels_ = &kernels::GetKernels();
+};
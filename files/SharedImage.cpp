@@ -0,0 +1,224 @@
+#include "SharedImage.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifndef __linux__
+#include <atomic>
+#endif
+
+constexpr uint32_t KSharedImageMagic = 0x31474D49;  // "IMG1"
+constexpr size_t KSharedHeaderSize = 64;
+constexpr size_t KRowAlignment = 64;
+#ifdef __linux__
+// Without these a peer could shrink the file after Open checked its size, and the next access to
+// the lost pages would raise SIGBUS in the receiving process.
+constexpr int KRequiredSeals = F_SEAL_SHRINK | F_SEAL_GROW;
+#endif
+
+namespace {
+
+struct SharedImageHeader {
+    uint32_t magic;
+    uint32_t format;
+    uint64_t width;
+    uint64_t height;
+    uint64_t stride;
+};
+static_assert(sizeof(SharedImageHeader) <= KSharedHeaderSize, "Header must fit before the pixels");
+
+std::runtime_error SystemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+int CreateAnonymousFile() {
+#ifdef __linux__
+    int fd = memfd_create("image_processor", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    static std::atomic<unsigned> counter(0);
+    std::string name = "/image_processor_" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd >= 0) {
+        shm_unlink(name.c_str());
+    }
+#endif
+    if (fd < 0) {
+        throw SystemError("Cannot create shared memory");
+    }
+    return fd;
+}
+
+// Fixes the size of a file made by CreateAnonymousFile. shm_open objects cannot be sealed.
+void SealSize(int fd) {
+#ifdef __linux__
+    if (fcntl(fd, F_ADD_SEALS, KRequiredSeals | F_SEAL_SEAL) != 0) {
+        throw SystemError("Cannot seal shared memory");
+    }
+#endif
+}
+
+void CheckSealed(int fd) {
+#ifdef __linux__
+    int seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || (seals & KRequiredSeals) != KRequiredSeals) {
+        throw std::runtime_error("Shared memory is not sealed against resizing");
+    }
+#endif
+}
+
+void* Map(int fd, size_t size) {
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw SystemError("Cannot map shared memory");
+    }
+    return mapping;
+}
+
+// Bytes needed for the header and `height` rows of `stride` bytes, or 0 on overflow.
+size_t GetMappingSize(uint64_t stride, uint64_t height) {
+    const uint64_t limit = std::numeric_limits<size_t>::max() - KSharedHeaderSize;
+    if (height != 0 && stride > limit / height) {
+        return 0;
+    }
+    return KSharedHeaderSize + static_cast<size_t>(stride * height);
+}
+
+}  // namespace
+
+SharedImage SharedImage::Create(size_t width, size_t height, PixelFormat format) {
+    size_t bytes_per_pixel = GetBytesPerPixel(format);
+    // Float rows also hold whole pixels so that ImportImage can wrap them without copying.
+    size_t alignment = format == PixelFormat::RgbFloat ? std::lcm(bytes_per_pixel, KRowAlignment) : KRowAlignment;
+    if (width > (std::numeric_limits<size_t>::max() - alignment) / bytes_per_pixel) {
+        throw std::invalid_argument("Shared image is too large");
+    }
+    size_t stride = (width * bytes_per_pixel + alignment - 1) / alignment * alignment;
+    size_t size = GetMappingSize(stride, height);
+    if (size == 0) {
+        throw std::invalid_argument("Shared image is too large");
+    }
+    int fd = CreateAnonymousFile();
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        std::runtime_error error = SystemError("Cannot resize shared memory");
+        close(fd);
+        throw error;
+    }
+    void* mapping = nullptr;
+    try {
+        SealSize(fd);
+        mapping = Map(fd, size);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    SharedImageHeader header = {KSharedImageMagic, static_cast<uint32_t>(format), width, height, stride};
+    std::memcpy(mapping, &header, sizeof(header));
+    return SharedImage(fd, mapping, size);
+}
+
+SharedImage SharedImage::Open(int fd) {
+    try {
+        CheckSealed(fd);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        std::runtime_error error = SystemError("Cannot inspect shared memory");
+        close(fd);
+        throw error;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (info.st_size < static_cast<off_t>(KSharedHeaderSize)) {
+        close(fd);
+        throw std::runtime_error("Shared memory is too small for an image");
+    }
+    void* mapping = nullptr;
+    try {
+        mapping = Map(fd, size);
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    // The constructor validates the header and releases fd and mapping if it is wrong.
+    return SharedImage(fd, mapping, size);
+}
+
+SharedImage::SharedImage(int fd, void* mapping, size_t size) : fd_(fd), mapping_(mapping), size_(size) {
+    SharedImageHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (header.magic != KSharedImageMagic ||
+        header.format > static_cast<uint32_t>(PixelFormat::RgbFloat)) {
+        Release();
+        throw std::runtime_error("Shared memory does not hold an image");
+    }
+    PixelFormat format = static_cast<PixelFormat>(header.format);
+    uint64_t max_width = std::numeric_limits<std::ptrdiff_t>::max() / GetBytesPerPixel(format);
+    size_t needed = GetMappingSize(header.stride, header.height);
+    if (header.width > max_width || header.stride < header.width * GetBytesPerPixel(format) ||
+        header.stride > static_cast<uint64_t>(std::numeric_limits<std::ptrdiff_t>::max()) || needed == 0 ||
+        needed > size_) {
+        Release();
+        throw std::runtime_error("Shared image header does not match its memory");
+    }
+    buffer_.data = static_cast<uint8_t*>(mapping_) + KSharedHeaderSize;
+    buffer_.width = static_cast<size_t>(header.width);
+    buffer_.height = static_cast<size_t>(header.height);
+    buffer_.stride = static_cast<std::ptrdiff_t>(header.stride);
+    buffer_.format = format;
+}
+
+SharedImage::SharedImage(SharedImage&& other) noexcept
+    : fd_(other.fd_), mapping_(other.mapping_), size_(other.size_), buffer_(other.buffer_) {
+    other.fd_ = -1;
+    other.mapping_ = nullptr;
+    other.size_ = 0;
+    other.buffer_ = ImageBuffer();
+}
+
+SharedImage& SharedImage::operator=(SharedImage&& other) noexcept {
+    if (this != &other) {
+        Release();
+        fd_ = other.fd_;
+        mapping_ = other.mapping_;
+        size_ = other.size_;
+        buffer_ = other.buffer_;
+        other.fd_ = -1;
+        other.mapping_ = nullptr;
+        other.size_ = 0;
+        other.buffer_ = ImageBuffer();
+    }
+    return *this;
+}
+
+SharedImage::~SharedImage() {
+    Release();
+}
+
+int SharedImage::GetFd() const {
+    return fd_;
+}
+
+const ImageBuffer& SharedImage::GetBuffer() const {
+    return buffer_;
+}
+
+void SharedImage::Release() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
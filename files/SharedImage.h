@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ImageBuffer.h"
+
+// An image in an anonymous shared-memory file (memfd on Linux, an unlinked shm_open object
+// elsewhere). The file starts with a small header describing the pixels, so the descriptor
+// alone is enough for another process to map the same image, e.g. after passing it over a
+// Unix socket or through fork.
+//
+// On Linux the memfd is sealed against shrinking and growing, and Open rejects descriptors
+// without those seals, so a peer cannot truncate the pixels under a receiver. shm_open
+// objects cannot be sealed: there any process holding the descriptor can still resize it,
+// so only share it with trusted processes.
+class SharedImage {
+public:
+    static SharedImage Create(size_t width, size_t height, PixelFormat format);
+    // Maps an image made by Create. Takes ownership of `fd`.
+    static SharedImage Open(int fd);
+
+    SharedImage(SharedImage&& other) noexcept;
+    SharedImage& operator=(SharedImage&& other) noexcept;
+    SharedImage(const SharedImage&) = delete;
+    SharedImage& operator=(const SharedImage&) = delete;
+    ~SharedImage();
+
+    int GetFd() const;
+    const ImageBuffer& GetBuffer() const;
+
+private:
+    SharedImage(int fd, void* mapping, size_t size);
+    void Release();
+
+    int fd_;
+    void* mapping_;
+    size_t size_;
+    ImageBuffer buffer_;
+};
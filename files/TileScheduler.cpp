@@ -0,0 +1,110 @@
+#include "TileScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+constexpr size_t KDefaultL2CacheSize = 256 * 1024;
+constexpr size_t KMinTileSize = 64;
+// Input tile, stage output, cropped stage output and the blur's intermediate pass.
+constexpr size_t KWorkingSetBuffers = 4;
+
+namespace {
+
+size_t GetL2CacheSize() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) {
+        return static_cast<size_t>(size);
+    }
+#endif
+    return KDefaultL2CacheSize;
+}
+
+size_t GetArea(const Region& region) {
+    return region.width * region.height;
+}
+
+}  // namespace
+
+TileScheduler::TileScheduler(size_t tile_size) : tile_size_(tile_size) {
+}
+
+Image TileScheduler::Run(const std::vector<std::unique_ptr<Filter>>& filters, Image image,
+                         const kernels::KernelTable& table) {
+    stats_ = TileStats();
+    FilterIterator first = filters.begin();
+    while (first != filters.end()) {
+        Region whole{0, 0, image.GetWidth(), image.GetHeight()};
+        FilterIterator last = first;
+        while (last != filters.end() && (*last)->GetInputRegion(whole, image.GetWidth(), image.GetHeight())) {
+            ++last;
+        }
+        if (last - first > 1) {
+            image = RunTiled(first, last, image, table);
+            first = last;
+        } else {
+            stats_.pixels_read += GetArea(whole);
+            image = (*first)->Apply(image, table);
+            stats_.pixels_written += image.GetWidth() * image.GetHeight();
+            ++first;
+        }
+    }
+    return image;
+}
+
+const TileStats& TileScheduler::GetStats() const {
+    return stats_;
+}
+
+Image TileScheduler::RunTiled(FilterIterator first, FilterIterator last, const Image& input,
+                              const kernels::KernelTable& table) {
+    size_t width = input.GetWidth();
+    size_t height = input.GetHeight();
+    if (width == 0 || height == 0) {
+        return Image(width, height);
+    }
+    size_t tile_size = tile_size_ > 0 ? tile_size_ : GetTileSize(first, last, width, height);
+    size_t stages = static_cast<size_t>(last - first);
+    Image output(width, height);
+    // regions[i] is the part of the image that filter i reads; regions[stages] is the tile itself.
+    std::vector<Region> regions(stages + 1);
+    for (size_t tile_y = 0; tile_y < height; tile_y += tile_size) {
+        for (size_t tile_x = 0; tile_x < width; tile_x += tile_size) {
+            regions[stages] = Region{tile_x, tile_y, std::min(tile_size, width - tile_x),
+                                     std::min(tile_size, height - tile_y)};
+            for (size_t stage = stages; stage > 0; --stage) {
+                regions[stage - 1] = *first[stage - 1]->GetInputRegion(regions[stage], width, height);
+            }
+            Image tile = input.CopyRegion(regions[0]);
+            stats_.pixels_read += GetArea(regions[0]);
+            for (size_t stage = 0; stage < stages; ++stage) {
+                Image stage_output = first[stage]->Apply(tile, table);
+                const Region& from = regions[stage];
+                const Region& to = regions[stage + 1];
+                if (from == to) {
+                    tile = std::move(stage_output);
+                } else {
+                    tile = stage_output.CopyRegion(Region{to.x - from.x, to.y - from.y, to.width, to.height});
+                }
+            }
+            output.PasteRegion(tile, Region{0, 0, tile.GetWidth(), tile.GetHeight()}, tile_x, tile_y);
+            stats_.pixels_written += GetArea(regions[stages]);
+            ++stats_.tiles;
+        }
+    }
+    return output;
+}
+
+size_t TileScheduler::GetTileSize(FilterIterator first, FilterIterator last, size_t width, size_t height) const {
+    Region footprint{width / 2, height / 2, 1, 1};
+    for (FilterIterator it = last; it != first;) {
+        --it;
+        footprint = *(*it)->GetInputRegion(footprint, width, height);
+    }
+    size_t halo = std::max(footprint.width, footprint.height) - 1;
+    size_t side = static_cast<size_t>(std::sqrt(GetL2CacheSize() / (KWorkingSetBuffers * sizeof(Pixel))));
+    return std::max(KMinTileSize, side > halo ? side - halo : 0);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Filter.h"
+#include <memory>
+#include <vector>
+
+// Estimated full-image traffic of a run, not a measurement: the pixels copied out of and
+// pasted into full-size images, plus the input and output of filters applied to the whole
+// image. Temporaries a filter allocates internally (the blur's horizontal pass, the edge
+// filter's grayscale and response images) and the per-tile buffers are not counted, and
+// nothing here says whether a pixel was actually served from cache or from DRAM.
+struct TileStats {
+    size_t tiles = 0;
+    size_t pixels_read = 0;
+    size_t pixels_written = 0;
+};
+
+// Runs a filter chain tile by tile: every consecutive group of filters that supports
+// GetInputRegion is applied to one tile (plus the halo its footprints require) before
+// moving on to the next, so the working set stays in L2 instead of streaming the whole
+// image through memory once per filter. Other filters are applied to the whole image.
+// The extra copies and halo recomputation only pay off in optimized builds; without
+// optimization the per-tile overhead dominates and tiling is slower than the plain chain.
+class TileScheduler {
+public:
+    // A tile_size of 0 picks the largest tile whose working set fits into L2.
+    explicit TileScheduler(size_t tile_size = 0);
+
+    Image Run(const std::vector<std::unique_ptr<Filter>>& filters, Image image,
+              const kernels::KernelTable& table = kernels::GetKernels());
+    const TileStats& GetStats() const;
+
+private:
+    using FilterIterator = std::vector<std::unique_ptr<Filter>>::const_iterator;
+
+    Image RunTiled(FilterIterator first, FilterIterator last, const Image& input, const kernels::KernelTable& table);
+    size_t GetTileSize(FilterIterator first, FilterIterator last, size_t width, size_t height) const;
+
+    size_t tile_size_;
+    TileStats stats_;
+};
@@ -3,6 +3,7 @@
 
 #include "BMP.h"
 #include "Filters.h"
+#include "Pipeline.h"
 #include <memory>
 #include <string>
 #include <vector>
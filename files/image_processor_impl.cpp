@@ -1,4 +1,5 @@
 #include "image_processor.h"
+#include "Kernels.h"
 #include <iostream>
 
 int ImageProcessorMain(int argc, const char* argv[]) {
@@ -7,11 +8,13 @@ int ImageProcessorMain(int argc, const char* argv[]) {
         std::cout << "Available filters:\n";
         std::cout << "  -crop width height\n  -gs\n  -neg\n  -sharp\n  -edge threshold\n  -blur sigma\n  -pixelate "
                      "block_size\n";
+        std::cout << "Options:\n";
+        std::cout << "  -simd scalar|sse4|avx2|avx512  force a kernel variant (default: best supported by the CPU)\n";
+        std::cout << "  -tiled                         tile the filter chain (faster only in optimized builds)\n";
         return 1;
     }
     try {
-        Image image = ReadBMP(argv[1]);
-        std::vector<std::unique_ptr<Filter>> filters;
+        Pipeline pipeline;
         for (int i = 3; i < argc; ++i) {
             std::string arg = argv[i];
             if (arg == "-crop") {
@@ -20,43 +23,48 @@ int ImageProcessorMain(int argc, const char* argv[]) {
                 }
                 size_t width = std::stoi(argv[i + 1]);
                 size_t height = std::stoi(argv[i + 2]);
-                filters.push_back(std::make_unique<CropFilter>(width, height));
+                pipeline.AddFilter(std::make_unique<CropFilter>(width, height));
                 i += 2;
             } else if (arg == "-gs") {
-                filters.push_back(std::make_unique<GrayscaleFilter>());
+                pipeline.AddFilter(std::make_unique<GrayscaleFilter>());
             } else if (arg == "-neg") {
-                filters.push_back(std::make_unique<NegativeFilter>());
+                pipeline.AddFilter(std::make_unique<NegativeFilter>());
             } else if (arg == "-sharp") {
-                filters.push_back(std::make_unique<SharpeningFilter>());
+                pipeline.AddFilter(std::make_unique<SharpeningFilter>());
             } else if (arg == "-edge") {
                 if (i + 1 >= argc) {
                     throw std::runtime_error("Not enough arguments for -edge");
                 }
                 float threshold = std::stof(argv[i + 1]);
-                filters.push_back(std::make_unique<EdgeDetectionFilter>(threshold));
+                pipeline.AddFilter(std::make_unique<EdgeDetectionFilter>(threshold));
                 i += 1;
             } else if (arg == "-blur") {
                 if (i + 1 >= argc) {
                     throw std::runtime_error("Not enough arguments for -blur");
                 }
                 float sigma = std::stof(argv[i + 1]);
-                filters.push_back(std::make_unique<GaussianBlurFilter>(sigma));
+                pipeline.AddFilter(std::make_unique<GaussianBlurFilter>(sigma));
                 i += 1;
             } else if (arg == "-pixelate") {
                 if (i + 1 >= argc) {
                     throw std::runtime_error("Not enough arguments for -pixelate");
                 }
                 size_t block_size = std::stoi(argv[i + 1]);
-                filters.push_back(std::make_unique<PixelateFilter>(block_size));
+                pipeline.AddFilter(std::make_unique<PixelateFilter>(block_size));
                 i += 1;
+            } else if (arg == "-simd") {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("Not enough arguments for -simd");
+                }
+                pipeline.SetSimdLevel(kernels::ParseSimdLevel(argv[i + 1]));
+                i += 1;
+            } else if (arg == "-tiled") {
+                pipeline.SetTiled(true);
             } else {
                 throw std::runtime_error("Unknown filter: " + arg);
             }
         }
-        for (const auto& filter : filters) {
-            image = filter->Apply(image);
-        }
-        WriteBMP(argv[2], image);
+        WriteBMP(argv[2], pipeline.Process(ReadBMP(argv[1], pipeline.GetKernels())), pipeline.GetKernels());
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << '\n';
         return 1;
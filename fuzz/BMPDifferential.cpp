@@ -0,0 +1,183 @@
+#include "BMP.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "SyntheticBMP.h"
+
+// Compares ReadBMP against the original stream-based decoder on a seeded synthetic
+// corpus and reports the throughput of both. Each input is also replayed truncated,
+// with oversized dimensions and with trailing bytes: the first two must be rejected,
+// the last must still decode like the original.
+// Usage: bmp_differential [seed] [count] [max_side]
+
+constexpr unsigned KDefaultSeed = 1;
+constexpr size_t KDefaultCount = 64;
+constexpr size_t KDefaultMaxSide = 256;
+constexpr float KMaxColorValue = 255.0f;
+constexpr double KBytesPerMegabyte = 1024.0 * 1024.0;
+constexpr size_t KMaxTrailingBytes = 64;
+
+namespace {
+
+// The decoder as it was before the in-memory rewrite: per-row reads and per-pixel SetPixel.
+Image LegacyReadBMP(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    BMPFileHeader file_header;
+    BMPInfoHeader info_header;
+    file.read(reinterpret_cast<char*>(&file_header), sizeof(file_header));
+    file.read(reinterpret_cast<char*>(&info_header), sizeof(info_header));
+
+    size_t width = static_cast<size_t>(std::abs(info_header.width));
+    size_t height = static_cast<size_t>(std::abs(info_header.height));
+    Image image(width, height);
+
+    file.seekg(file_header.offset, std::ios::beg);
+    size_t padding = (4 - (width * 3) % 4) % 4;
+    std::vector<unsigned char> pixel_data(width * 3);
+    for (size_t y = 0; y < height; ++y) {
+        file.read(reinterpret_cast<char*>(pixel_data.data()), static_cast<std::streamsize>(width * 3));
+        file.seekg(static_cast<std::streamoff>(padding), std::ios::cur);
+        for (size_t x = 0; x < width; ++x) {
+            size_t offset = x * 3;
+            unsigned char b = pixel_data[offset];
+            unsigned char g = pixel_data[offset + 1];
+            unsigned char r = pixel_data[offset + 2];
+            image.SetPixel(x, y,
+                           Pixel(static_cast<float>(r) / KMaxColorValue, static_cast<float>(g) / KMaxColorValue,
+                                 static_cast<float>(b) / KMaxColorValue));
+        }
+    }
+    return image;
+}
+
+bool SameImage(const Image& expected, const Image& actual) {
+    if (expected.GetWidth() != actual.GetWidth() || expected.GetHeight() != actual.GetHeight()) {
+        return false;
+    }
+    for (size_t y = 0; y < expected.GetHeight(); ++y) {
+        for (size_t x = 0; x < expected.GetWidth(); ++x) {
+            if (!(expected.GetPixel(static_cast<int>(x), static_cast<int>(y)) ==
+                  actual.GetPixel(static_cast<int>(x), static_cast<int>(y)))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void WriteFile(const std::filesystem::path& path, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+bool IsRejected(const std::filesystem::path& path) {
+    try {
+        ReadBMP(path.string());
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+// Cuts the file anywhere before the end of its pixel data.
+std::vector<uint8_t> Truncate(std::vector<uint8_t> data, std::mt19937& rng) {
+    data.resize(rng() % data.size());
+    return data;
+}
+
+// Claims either one side over KMaxBMPDimension, or two sides within it whose product is
+// over KMaxBMPPixels. The file itself keeps its original small size.
+std::vector<uint8_t> Oversize(std::vector<uint8_t> data, std::mt19937& rng) {
+    int32_t width = static_cast<int32_t>(KMaxBMPDimension + 1);
+    int32_t height = 1;
+    if (rng() % 2 == 0) {
+        width = static_cast<int32_t>(KMaxBMPDimension / 2);
+        height = width;
+    }
+    if (rng() % 2 == 0) {
+        std::swap(width, height);
+    }
+    std::memcpy(data.data() + synthetic::KWidthOffset, &width, sizeof(width));
+    std::memcpy(data.data() + synthetic::KHeightOffset, &height, sizeof(height));
+    return data;
+}
+
+std::vector<uint8_t> AppendTrailingBytes(std::vector<uint8_t> data, std::mt19937& rng) {
+    data.resize(data.size() + 1 + rng() % KMaxTrailingBytes, static_cast<uint8_t>(rng()));
+    return data;
+}
+
+template <class Decoder>
+Image Timed(Decoder decoder, const std::string& path, double& seconds) {
+    auto start = std::chrono::steady_clock::now();
+    Image image = decoder(path);
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return image;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned seed = argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : KDefaultSeed;
+    size_t count = argc > 2 ? std::stoul(argv[2]) : KDefaultCount;
+    size_t max_side = argc > 3 ? std::stoul(argv[3]) : KDefaultMaxSide;
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                 ("bmp_differential_" + std::to_string(seed) + ".bmp");
+    std::mt19937 rng(seed);
+    size_t total_bytes = 0;
+    size_t mismatches = 0;
+    size_t accepted_malformed = 0;
+    double legacy_seconds = 0.0;
+    double current_seconds = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<uint8_t> data = synthetic::MakeBMP(rng, max_side);
+        WriteFile(path, data);
+        total_bytes += data.size();
+        Image expected = Timed(LegacyReadBMP, path.string(), legacy_seconds);
+        Image actual = Timed([](const std::string& file) { return ReadBMP(file); }, path.string(), current_seconds);
+        if (!SameImage(expected, actual)) {
+            std::cerr << "Mismatch on input " << i << " (" << expected.GetWidth() << "x" << expected.GetHeight()
+                      << ")\n";
+            ++mismatches;
+        }
+
+        WriteFile(path, Truncate(data, rng));
+        if (!IsRejected(path)) {
+            std::cerr << "Accepted truncated input " << i << "\n";
+            ++accepted_malformed;
+        }
+        WriteFile(path, Oversize(data, rng));
+        if (!IsRejected(path)) {
+            std::cerr << "Accepted oversized input " << i << "\n";
+            ++accepted_malformed;
+        }
+        WriteFile(path, AppendTrailingBytes(data, rng));
+        if (!SameImage(expected, ReadBMP(path.string()))) {
+            std::cerr << "Mismatch on input " << i << " with trailing bytes\n";
+            ++mismatches;
+        }
+    }
+    std::filesystem::remove(path);
+
+    double megabytes = static_cast<double>(total_bytes) / KBytesPerMegabyte;
+    std::cout << count << " images, " << megabytes << " MiB, seed " << seed << "\n";
+    std::cout << "legacy:  " << megabytes / legacy_seconds << " MiB/s\n";
+    std::cout << "current: " << megabytes / current_seconds << " MiB/s\n";
+    if (mismatches > 0 || accepted_malformed > 0) {
+        std::cerr << mismatches << " mismatches, " << accepted_malformed << " malformed inputs accepted\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "BMP.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+
+std::optional<Image> TryDecode(const uint8_t* data, size_t size) {
+    try {
+        return DecodeBMP(data, size);
+    } catch (const std::runtime_error&) {
+        return std::nullopt;
+    }
+}
+
+// One scratch file per process, removed on normal exit.
+class ScratchFile {
+public:
+    ScratchFile()
+        : path_(std::filesystem::temp_directory_path() / ("bmp_fuzzer_" + std::to_string(getpid()) + ".bmp")) {
+    }
+    ~ScratchFile() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+    std::string GetPath() const {
+        return path_.string();
+    }
+
+private:
+    std::filesystem::path path_;
+};
+
+// ReadBMP validates the file size and its short reads separately from DecodeBMP, so every
+// input is also written out and read back through the file path.
+std::optional<Image> TryRead(const uint8_t* data, size_t size) {
+    static const ScratchFile scratch;
+    const std::string path = scratch.GetPath();
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+    try {
+        return ReadBMP(path);
+    } catch (const std::runtime_error&) {
+        return std::nullopt;
+    }
+}
+
+bool SameImage(const Image& lhs, const Image& rhs) {
+    if (lhs.GetWidth() != rhs.GetWidth() || lhs.GetHeight() != rhs.GetHeight()) {
+        return false;
+    }
+    for (size_t y = 0; y < lhs.GetHeight() && lhs.GetWidth() > 0; ++y) {
+        if (std::memcmp(lhs.GetRow(y), rhs.GetRow(y), lhs.GetWidth() * sizeof(Pixel)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// libFuzzer entry point. Malformed input must be rejected with std::runtime_error, and
+// ReadBMP must accept exactly what DecodeBMP accepts and decode it the same way; anything
+// else (crash, sanitizer report, std::bad_alloc, disagreement) is a finding.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::optional<Image> decoded = TryDecode(data, size);
+    if (decoded && decoded->GetWidth() * decoded->GetHeight() > KMaxBMPPixels) {
+        __builtin_trap();
+    }
+    std::optional<Image> read = TryRead(data, size);
+    if (decoded.has_value() != read.has_value() || (decoded && !SameImage(*decoded, *read))) {
+        __builtin_trap();
+    }
+    return 0;
+}
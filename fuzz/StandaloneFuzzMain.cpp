@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include "SyntheticBMP.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// Driver for compilers without libFuzzer. With file arguments it replays them (e.g. a
+// crash reproducer); otherwise it runs seeded mutations of synthetic BMP files.
+
+constexpr unsigned KSeed = 1;
+constexpr size_t KIterations = 20000;
+constexpr size_t KMaxSide = 32;
+constexpr size_t KMaxFlips = 8;
+constexpr size_t KMaxAppended = 64;
+
+namespace {
+
+const uint32_t KInterestingValues[] = {0, 1, 0x7F, 0xFF, 0xFFFF, 0x10000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF};
+
+void Mutate(std::vector<uint8_t>& data, std::mt19937& rng) {
+    switch (rng() % 4) {
+        case 0:
+            for (size_t flips = 1 + rng() % KMaxFlips; flips > 0; --flips) {
+                data[rng() % data.size()] ^= static_cast<uint8_t>(1u << (rng() % 8));
+            }
+            break;
+        case 1:
+            data.resize(rng() % data.size());
+            break;
+        case 2:
+            data.resize(data.size() + 1 + rng() % KMaxAppended, static_cast<uint8_t>(rng()));
+            break;
+        default: {
+            const size_t fields[] = {synthetic::KWidthOffset, synthetic::KHeightOffset,
+                                     synthetic::KPixelOffsetOffset};
+            size_t field = fields[rng() % std::size(fields)];
+            uint32_t value = KInterestingValues[rng() % std::size(KInterestingValues)];
+            std::memcpy(data.data() + field, &value, sizeof(value));
+            break;
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        return 0;
+    }
+    std::mt19937 rng(KSeed);
+    for (size_t i = 0; i < KIterations; ++i) {
+        std::vector<uint8_t> data = synthetic::MakeBMP(rng, KMaxSide);
+        Mutate(data, rng);
+        LLVMFuzzerTestOneInput(data.data(), data.size());
+    }
+    std::cout << "Ran " << KIterations << " mutated inputs\n";
+    return 0;
+}
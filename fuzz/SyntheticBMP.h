@@ -0,0 +1,48 @@
+#pragma once
+
+#include "BMP.h"
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace synthetic {
+
+constexpr size_t KMaxGap = 64;
+constexpr size_t KPixelOffsetOffset = 10;
+constexpr size_t KWidthOffset = 18;
+constexpr size_t KHeightOffset = 22;
+
+// A valid 24-bit BMP of random size and content. The pixel array sometimes starts
+// after a gap, so decoders have to honour file_header.offset.
+inline std::vector<uint8_t> MakeBMP(std::mt19937& rng, size_t max_side) {
+    std::uniform_int_distribution<size_t> side(1, max_side);
+    std::uniform_int_distribution<size_t> gap(0, KMaxGap);
+    std::uniform_int_distribution<int> byte(0, UINT8_MAX);
+    size_t width = side(rng);
+    size_t height = side(rng);
+    size_t offset = sizeof(BMPFileHeader) + sizeof(BMPInfoHeader) + (rng() % 2 == 0 ? 0 : gap(rng));
+    size_t row_size = (width * 3 + 3) / 4 * 4;
+    std::vector<uint8_t> data(offset + row_size * height);
+
+    BMPFileHeader file_header = {0x4D42, static_cast<uint32_t>(data.size()), 0, 0, static_cast<uint32_t>(offset)};
+    BMPInfoHeader info_header = {static_cast<uint32_t>(sizeof(BMPInfoHeader)),
+                                 static_cast<int32_t>(width),
+                                 static_cast<int32_t>(height),
+                                 1,
+                                 24,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 0};
+    std::memcpy(data.data(), &file_header, sizeof(file_header));
+    std::memcpy(data.data() + sizeof(file_header), &info_header, sizeof(info_header));
+    for (size_t i = sizeof(file_header) + sizeof(info_header); i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(byte(rng));
+    }
+    return data;
+}
+
+}  // namespace synthetic
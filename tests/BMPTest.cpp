@@ -1,8 +1,33 @@
 #include "BMP.h"
 #include <gtest/gtest.h>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <vector>
 #include "Constants.h"
 
+namespace {
+
+constexpr size_t KWidthOffset = 18;
+constexpr size_t KHeightOffset = 22;
+constexpr size_t KPixelOffsetOffset = 10;
+constexpr int32_t KHugeDimension = 0x7FFFFFFF;
+
+std::vector<uint8_t> EncodeTestImage() {
+    Image image(constants::ImageTestSize, constants::ImageTestSize);
+    image.SetPixel(1, 1, Pixel(constants::HalfIntensity, constants::LowIntensity, constants::FullIntensity));
+    std::string temp_file = testing::TempDir() + "encoded.bmp";
+    WriteBMP(temp_file, image);
+    std::ifstream file(temp_file, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void SetField(std::vector<uint8_t>& data, size_t offset, int32_t value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+}  // namespace
+
 TEST(BMPTest, ReadWrite) {
     Image original(constants::CropTestWidth, constants::CropTestHeight);
     original.SetPixel(0, 0, Pixel(constants::NoIntensity, constants::NoIntensity, constants::NoIntensity));
@@ -28,4 +53,40 @@ TEST(BMPTest, ReadInvalid) {
     f.write("INVALID", constants::InvalidStringLength);
     f.close();
     EXPECT_THROW(ReadBMP(temp_file), std::runtime_error);
+}
+
+TEST(BMPTest, DecodeFromMemory) {
+    std::vector<uint8_t> data = EncodeTestImage();
+    Image image = DecodeBMP(data.data(), data.size());
+    EXPECT_EQ(image.GetWidth(), constants::ImageTestSize);
+    EXPECT_EQ(image.GetHeight(), constants::ImageTestSize);
+    EXPECT_NEAR(image.GetPixel(1, 1).r, constants::HalfIntensity, constants::FullIntensity / 255);
+    EXPECT_NEAR(image.GetPixel(1, 1).b, constants::FullIntensity, constants::FullIntensity / 255);
+}
+
+TEST(BMPTest, DecodeTruncated) {
+    std::vector<uint8_t> data = EncodeTestImage();
+    EXPECT_THROW(DecodeBMP(data.data(), data.size() - 1), std::runtime_error);
+    EXPECT_THROW(DecodeBMP(data.data(), sizeof(BMPFileHeader)), std::runtime_error);
+    std::string temp_file = testing::TempDir() + "truncated.bmp";
+    std::ofstream f(temp_file, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() - 1));
+    f.close();
+    EXPECT_THROW(ReadBMP(temp_file), std::runtime_error);
+}
+
+TEST(BMPTest, DecodeHostileHeader) {
+    std::vector<uint8_t> data = EncodeTestImage();
+    std::vector<uint8_t> huge = data;
+    SetField(huge, KWidthOffset, KHugeDimension);
+    SetField(huge, KHeightOffset, KHugeDimension);
+    EXPECT_THROW(DecodeBMP(huge.data(), huge.size()), std::runtime_error);
+    std::vector<uint8_t> negative = data;
+    SetField(negative, KWidthOffset, -constants::ImageTestSize);
+    EXPECT_THROW(DecodeBMP(negative.data(), negative.size()), std::runtime_error);
+    std::vector<uint8_t> bad_offset = data;
+    SetField(bad_offset, KPixelOffsetOffset, 0);
+    EXPECT_THROW(DecodeBMP(bad_offset.data(), bad_offset.size()), std::runtime_error);
+    SetField(bad_offset, KPixelOffsetOffset, KHugeDimension);
+    EXPECT_THROW(DecodeBMP(bad_offset.data(), bad_offset.size()), std::runtime_error);
 }
\ No newline at end of file
@@ -17,4 +17,5 @@ constexpr int CropTestWidth = 2;
 constexpr int CropTestHeight = 2;
 constexpr int ImageTestSize = 3;
 constexpr int ArgCountInvalidCrop = 6;
+constexpr int ArgCountSimd = 5;
 }  // namespace constants
\ No newline at end of file
@@ -63,4 +63,23 @@ TEST(GaussianBlurFilterTest, InvalidSigma) {
 
 TEST(PixelateFilterTest, InvalidBlockSize) {
     EXPECT_THROW(PixelateFilter(0), std::invalid_argument);
+}
+
+TEST(FilterInputRegionTest, ConvolutionExpandsAndClips) {
+    Region output{0, 1, 1, 1};
+    EXPECT_EQ(SharpeningFilter().GetInputRegion(output, constants::ImageTestSize, constants::ImageTestSize),
+              Region({0, 0, 2, 3}));
+    EXPECT_EQ(GrayscaleFilter().GetInputRegion(output, constants::ImageTestSize, constants::ImageTestSize), output);
+}
+
+TEST(FilterInputRegionTest, PixelateAlignsToBlocks) {
+    Region output{1, 2, 1, 1};
+    EXPECT_EQ(PixelateFilter(constants::CropTestWidth)
+                  .GetInputRegion(output, constants::ImageTestSize, constants::ImageTestSize),
+              Region({0, 2, 2, 1}));
+}
+
+TEST(FilterInputRegionTest, CropIsNotTileable) {
+    Region output{0, 0, 1, 1};
+    EXPECT_FALSE(CropFilter(1, 1).GetInputRegion(output, constants::ImageTestSize, constants::ImageTestSize));
 }
\ No newline at end of file
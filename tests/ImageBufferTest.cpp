@@ -0,0 +1,81 @@
+#include "ImageBuffer.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "Constants.h"
+#include "TestImages.h"
+
+namespace {
+
+constexpr size_t KWidth = 5;
+constexpr size_t KHeight = 4;
+constexpr size_t KBgrStride = 20;
+constexpr size_t KFloatStride = 7;
+// Cache-line padding that is not a whole number of 12-byte float pixels.
+constexpr size_t KPaddedFloatStride = 64;
+constexpr uint8_t KBlue = 10;
+constexpr uint8_t KGreen = 128;
+constexpr uint8_t KRed = 255;
+
+}  // namespace
+
+TEST(ImageBufferTest, ImportBgrWithStride) {
+    std::vector<uint8_t> bytes(KBgrStride * KHeight);
+    size_t offset = KBgrStride * 2 + 3 * 3;
+    bytes[offset] = KBlue;
+    bytes[offset + 1] = KGreen;
+    bytes[offset + 2] = KRed;
+    Image image = ImportImage(ImageBuffer{bytes.data(), KWidth, KHeight, KBgrStride, PixelFormat::Bgr8});
+    EXPECT_FLOAT_EQ(image.GetPixel(3, 2).r, constants::FullIntensity);
+    EXPECT_FLOAT_EQ(image.GetPixel(3, 2).g, KGreen / 255.0f);
+    EXPECT_FLOAT_EQ(image.GetPixel(3, 2).b, KBlue / 255.0f);
+    EXPECT_EQ(image.GetPixel(2, 2), Pixel());
+}
+
+TEST(ImageBufferTest, BgrRoundTripTopDown) {
+    Image source = test_images::MakePattern(KWidth, KHeight);
+    std::vector<uint8_t> bytes(KBgrStride * KHeight);
+    ImageBuffer top_down{bytes.data() + KBgrStride * (KHeight - 1), KWidth, KHeight,
+                         -static_cast<std::ptrdiff_t>(KBgrStride), PixelFormat::Bgr8};
+    ExportImage(source, top_down);
+    EXPECT_EQ(bytes[2], static_cast<uint8_t>(source.GetPixel(0, KHeight - 1).r * 255.0f));
+    Image read_back = ImportImage(top_down);
+    for (size_t y = 0; y < KHeight; ++y) {
+        for (size_t x = 0; x < KWidth; ++x) {
+            EXPECT_NEAR(read_back.GetPixel(x, y).g, source.GetPixel(x, y).g, constants::FullIntensity / 255);
+        }
+    }
+}
+
+TEST(ImageBufferTest, ImportFloatIsZeroCopy) {
+    std::vector<Pixel> pixels(KFloatStride * KHeight);
+    ImageBuffer buffer{pixels.data(), KWidth, KHeight, KFloatStride * sizeof(Pixel), PixelFormat::RgbFloat};
+    Image image = ImportImage(buffer);
+    EXPECT_EQ(image.GetRow(1), pixels.data() + KFloatStride);
+    pixels[KFloatStride + 2] = Pixel(constants::LowIntensity, constants::LowIntensity, constants::LowIntensity);
+    EXPECT_EQ(image.GetPixel(2, 1), pixels[KFloatStride + 2]);
+}
+
+TEST(ImageBufferTest, FloatPaddedStrideIsCopied) {
+    Image source = test_images::MakePattern(KWidth, KHeight);
+    std::vector<uint8_t> bytes(KPaddedFloatStride * KHeight + 1);
+    for (uint8_t* data : {bytes.data(), bytes.data() + 1}) {
+        ImageBuffer buffer{data, KWidth, KHeight, KPaddedFloatStride, PixelFormat::RgbFloat};
+        ExportImage(source, buffer);
+        Image image = ImportImage(buffer);
+        EXPECT_NE(reinterpret_cast<uint8_t*>(image.GetRow(0)), data);
+        test_images::ExpectSameImage(source, image);
+    }
+}
+
+TEST(ImageBufferTest, InvalidBuffers) {
+    std::vector<Pixel> pixels(KFloatStride * KHeight);
+    EXPECT_THROW(ImportImage(ImageBuffer{nullptr, KWidth, KHeight, KBgrStride, PixelFormat::Bgr8}),
+                 std::invalid_argument);
+    EXPECT_THROW(ImportImage(ImageBuffer{pixels.data(), KWidth, KHeight, KWidth, PixelFormat::Bgr8}),
+                 std::invalid_argument);
+    Image image(KWidth, KWidth);
+    EXPECT_THROW(ExportImage(image, ImageBuffer{pixels.data(), KWidth, KHeight, KFloatStride * sizeof(Pixel),
+                                                PixelFormat::RgbFloat}),
+                 std::invalid_argument);
+}
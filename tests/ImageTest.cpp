@@ -1,5 +1,6 @@
 #include "Image.h"
 #include <gtest/gtest.h>
+#include <vector>
 #include "Constants.h"
 
 TEST(ImageTest, ConstructorValid) {
@@ -40,4 +41,31 @@ TEST(ImageTest, SetPixelOutOfBounds) {
                       Pixel(constants::NoIntensity, constants::NoIntensity, constants::NoIntensity));
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(ImageTest, ViewWrapsCallerPixels) {
+    std::vector<Pixel> pixels(constants::ImageTestSize * constants::ImageTestSize);
+    Image view(pixels.data(), constants::ImageTestSize, constants::ImageTestSize, constants::ImageTestSize);
+    view.SetPixel(1, 2, Pixel(constants::HalfIntensity, constants::HalfIntensity, constants::HalfIntensity));
+    EXPECT_EQ(pixels[2 * constants::ImageTestSize + 1],
+              Pixel(constants::HalfIntensity, constants::HalfIntensity, constants::HalfIntensity));
+    EXPECT_EQ(view.GetRow(1), pixels.data() + constants::ImageTestSize);
+}
+
+TEST(ImageTest, ViewWithNegativeStride) {
+    std::vector<Pixel> pixels(constants::ImageTestSize * constants::ImageTestSize);
+    Pixel* last_row = pixels.data() + (constants::ImageTestSize - 1) * constants::ImageTestSize;
+    Image view(last_row, constants::ImageTestSize, constants::ImageTestSize, -constants::ImageTestSize);
+    view.SetPixel(0, 0, Pixel(constants::FullIntensity, constants::FullIntensity, constants::FullIntensity));
+    EXPECT_EQ(*last_row, Pixel(constants::FullIntensity, constants::FullIntensity, constants::FullIntensity));
+    EXPECT_EQ(view.GetRow(constants::ImageTestSize - 1), pixels.data());
+}
+
+TEST(ImageTest, CopyOfViewOwnsPixels) {
+    std::vector<Pixel> pixels(constants::ImageTestSize * constants::ImageTestSize);
+    Image view(pixels.data(), constants::ImageTestSize, constants::ImageTestSize, constants::ImageTestSize);
+    Image copy = view;
+    copy.SetPixel(0, 0, Pixel(constants::FullIntensity, constants::FullIntensity, constants::FullIntensity));
+    EXPECT_EQ(pixels[0], Pixel(constants::NoIntensity, constants::NoIntensity, constants::NoIntensity));
+    EXPECT_EQ(view.GetPixel(0, 0), Pixel(constants::NoIntensity, constants::NoIntensity, constants::NoIntensity));
+}
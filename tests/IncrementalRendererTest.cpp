@@ -0,0 +1,101 @@
+#include "Filters.h"
+#include "IncrementalRenderer.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "Constants.h"
+#include "TestImages.h"
+
+namespace {
+
+using test_images::KImageHeight;
+using test_images::KImageWidth;
+using test_images::MakeSharpBlurEdge;
+
+constexpr size_t KPixelateBlock = 4;
+constexpr size_t KCropWidth = 100;
+constexpr size_t KCropHeight = 60;
+constexpr size_t KEditX = 40;
+constexpr size_t KEditY = 30;
+constexpr size_t KEditSize = 5;
+// Editing one pixel: sharpening recomputes its 3x3 neighbourhood from a 5x5 input, then the
+// blur recomputes that neighbourhood grown by ceil(3 * KChainSigma) from an input grown once more.
+constexpr size_t KBlurRadius = 3;
+constexpr size_t KSharpPatch = 5;
+constexpr size_t KBlurPatch = 3 + 4 * KBlurRadius;
+
+Image RenderFromScratch(std::vector<std::unique_ptr<Filter>> filters, const Image& input) {
+    IncrementalRenderer renderer(std::move(filters));
+    return renderer.Render(input);
+}
+
+Image Edit(Image image, size_t x0, size_t y0, size_t size) {
+    for (size_t y = y0; y < y0 + size; ++y) {
+        for (size_t x = x0; x < x0 + size; ++x) {
+            image.SetPixel(x, y, Pixel(constants::FullIntensity, constants::NoIntensity, constants::HalfIntensity));
+        }
+    }
+    return image;
+}
+
+}  // namespace
+
+TEST(IncrementalRendererTest, DiffMatchesFullRender) {
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(MakeSharpBlurEdge());
+    renderer.Render(input);
+    Image edited = Edit(input, KEditX, KEditY, KEditSize);
+    test_images::ExpectSameImage(RenderFromScratch(MakeSharpBlurEdge(), edited), renderer.Update(edited));
+    EXPECT_LT(renderer.GetRecomputedPixels(), KImageWidth * KImageHeight);
+}
+
+TEST(IncrementalRendererTest, HintAtImageCorner) {
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(MakeSharpBlurEdge());
+    renderer.Render(input);
+    Image edited = Edit(input, 0, 0, KEditSize);
+    test_images::ExpectSameImage(RenderFromScratch(MakeSharpBlurEdge(), edited),
+                                 renderer.Update(edited, Region{0, 0, KEditSize, KEditSize}));
+}
+
+TEST(IncrementalRendererTest, PixelateAndCrop) {
+    auto make_filters = [] {
+        std::vector<std::unique_ptr<Filter>> filters;
+        filters.push_back(std::make_unique<PixelateFilter>(KPixelateBlock));
+        filters.push_back(std::make_unique<SharpeningFilter>());
+        filters.push_back(std::make_unique<CropFilter>(KCropWidth, KCropHeight));
+        filters.push_back(std::make_unique<GrayscaleFilter>());
+        return filters;
+    };
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(make_filters());
+    renderer.Render(input);
+    Image edited = Edit(input, KEditX + 1, KEditY + 1, KEditSize);
+    test_images::ExpectSameImage(RenderFromScratch(make_filters(), edited), renderer.Update(edited));
+}
+
+TEST(IncrementalRendererTest, RecomputesOnlyFootprint) {
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<SharpeningFilter>());
+    filters.push_back(std::make_unique<GaussianBlurFilter>(test_images::KChainSigma));
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(std::move(filters));
+    renderer.Render(input);
+    renderer.Update(Edit(input, KEditX, KEditY, 1));
+    EXPECT_EQ(renderer.GetRecomputedPixels(), KSharpPatch * KSharpPatch + KBlurPatch * KBlurPatch);
+}
+
+TEST(IncrementalRendererTest, UnchangedInput) {
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(MakeSharpBlurEdge());
+    renderer.Render(input);
+    renderer.Update(input);
+    EXPECT_EQ(renderer.GetRecomputedPixels(), 0);
+}
+
+TEST(IncrementalRendererTest, UpdateBeforeRender) {
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    IncrementalRenderer renderer(MakeSharpBlurEdge());
+    EXPECT_THROW(renderer.GetOutput(), std::logic_error);
+    test_images::ExpectSameImage(RenderFromScratch(MakeSharpBlurEdge(), input), renderer.Update(input));
+}
@@ -0,0 +1,95 @@
+#include "BMP.h"
+#include "Filters.h"
+#include "Kernels.h"
+#include "Pipeline.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "TestImages.h"
+
+namespace {
+
+constexpr float KEdgeThreshold = 0.05f;
+constexpr float KSmallSigma = 0.7f;
+constexpr float KLargeSigma = 12.0f;
+
+const std::vector<kernels::SimdLevel> KAllLevels = {kernels::SimdLevel::Scalar, kernels::SimdLevel::Sse4,
+                                                    kernels::SimdLevel::Avx2, kernels::SimdLevel::Avx512};
+
+class KernelsTest : public testing::TestWithParam<kernels::SimdLevel> {
+protected:
+    void SetUp() override {
+        if (!kernels::IsSimdLevelSupported(GetParam())) {
+            GTEST_SKIP() << kernels::SimdLevelName(GetParam()) << " is not supported by this CPU";
+        }
+    }
+
+    void ExpectMatchesScalar(const Filter& filter, const Image& input) {
+        Image expected = filter.Apply(input, kernels::GetKernels(kernels::SimdLevel::Scalar));
+        Image actual = filter.Apply(input, kernels::GetKernels(GetParam()));
+        test_images::ExpectSameImage(expected, actual);
+    }
+
+    void ExpectMatchesScalarOnAllShapes(const Filter& filter) {
+        ExpectMatchesScalar(filter, test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight));
+        ExpectMatchesScalar(filter, test_images::MakePattern(test_images::KWideHeight, test_images::KWideWidth));
+        ExpectMatchesScalar(filter, test_images::MakePattern(1, 1));
+        ExpectMatchesScalar(filter, test_images::MakePattern(2, 3));
+    }
+};
+
+}  // namespace
+
+TEST_P(KernelsTest, Grayscale) {
+    ExpectMatchesScalarOnAllShapes(GrayscaleFilter());
+}
+
+TEST_P(KernelsTest, Sharpening) {
+    ExpectMatchesScalarOnAllShapes(SharpeningFilter());
+}
+
+TEST_P(KernelsTest, EdgeDetection) {
+    ExpectMatchesScalarOnAllShapes(EdgeDetectionFilter(KEdgeThreshold));
+}
+
+TEST_P(KernelsTest, GaussianBlur) {
+    ExpectMatchesScalarOnAllShapes(GaussianBlurFilter(KSmallSigma));
+    ExpectMatchesScalarOnAllShapes(GaussianBlurFilter(KLargeSigma));
+}
+
+TEST_P(KernelsTest, BMPRoundTrip) {
+    Image input = test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight);
+    std::string scalar_file = testing::TempDir() + "kernels_scalar.bmp";
+    std::string simd_file = testing::TempDir() + "kernels_simd.bmp";
+    const kernels::KernelTable& scalar = kernels::GetKernels(kernels::SimdLevel::Scalar);
+    const kernels::KernelTable& simd = kernels::GetKernels(GetParam());
+    WriteBMP(scalar_file, input, scalar);
+    Image expected = ReadBMP(scalar_file, scalar);
+    WriteBMP(simd_file, input, simd);
+    test_images::ExpectSameImage(expected, ReadBMP(simd_file, simd));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, KernelsTest, testing::ValuesIn(KAllLevels),
+                         [](const testing::TestParamInfo<kernels::SimdLevel>& info) {
+                             return std::string(kernels::SimdLevelName(info.param));
+                         });
+
+TEST(SimdLevelTest, DetectedLevelIsSupported) {
+    EXPECT_TRUE(kernels::IsSimdLevelSupported(kernels::DetectSimdLevel()));
+    EXPECT_TRUE(kernels::IsSimdLevelSupported(kernels::SimdLevel::Scalar));
+}
+
+TEST(SimdLevelTest, ParseNames) {
+    for (kernels::SimdLevel level : KAllLevels) {
+        EXPECT_EQ(kernels::ParseSimdLevel(kernels::SimdLevelName(level)), level);
+    }
+    EXPECT_THROW(kernels::ParseSimdLevel("neon"), std::runtime_error);
+}
+
+TEST(SimdLevelTest, ForcedLevelIsPerPipeline) {
+    Pipeline forced;
+    forced.SetSimdLevel(kernels::SimdLevel::Scalar);
+    EXPECT_EQ(&forced.GetKernels(), &kernels::GetKernels(kernels::SimdLevel::Scalar));
+    EXPECT_EQ(&Pipeline().GetKernels(), &kernels::GetKernels());
+    EXPECT_EQ(&kernels::GetKernels(), &kernels::GetKernels(kernels::DetectSimdLevel()));
+}
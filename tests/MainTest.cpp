@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <sstream>
 #include "Constants.h"
+#include "TestImages.h"
 
 int RunMain(int argc, const char* argv[]) {
     return ImageProcessorMain(argc, argv);
@@ -32,4 +33,28 @@ TEST(MainTest, InputFileNotFound) {
     const char* argv[] = {"image_processor", "non_existent.bmp", "output.bmp"};
     int argc = 3;
     EXPECT_EQ(RunMain(argc, argv), 1);
-}
\ No newline at end of file
+}
+
+TEST(MainTest, UnknownSimdLevel) {
+    std::string input_file = testing::TempDir() + "main_unknown_simd_input.bmp";
+    std::string output_file = testing::TempDir() + "main_unknown_simd_output.bmp";
+    WriteBMP(input_file, test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight));
+    const char* argv[] = {"image_processor", input_file.c_str(), output_file.c_str(), "-simd", "neon"};
+    int argc = constants::ArgCountSimd;
+    EXPECT_EQ(RunMain(argc, argv), 1);
+    argv[4] = "scalar";
+    EXPECT_EQ(RunMain(argc, argv), 0);
+}
+
+TEST(MainTest, ForcedSimdLevelMatchesDefault) {
+    std::string input_file = testing::TempDir() + "main_simd_input.bmp";
+    std::string default_file = testing::TempDir() + "main_simd_default.bmp";
+    std::string scalar_file = testing::TempDir() + "main_simd_scalar.bmp";
+    WriteBMP(input_file, test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight));
+    const char* default_argv[] = {"image_processor", input_file.c_str(), default_file.c_str(), "-sharp"};
+    EXPECT_EQ(RunMain(constants::ArgCountSimd - 1, default_argv), 0);
+    const char* scalar_argv[] = {"image_processor", input_file.c_str(), scalar_file.c_str(), "-simd", "scalar",
+                                 "-sharp"};
+    EXPECT_EQ(RunMain(constants::ArgCountSimd + 1, scalar_argv), 0);
+    test_images::ExpectSameImage(ReadBMP(default_file), ReadBMP(scalar_file));
+}
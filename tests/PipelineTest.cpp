@@ -0,0 +1,138 @@
+#include "Filters.h"
+#include "Pipeline.h"
+#include "SharedImage.h"
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Constants.h"
+#include "TestImages.h"
+
+namespace {
+
+constexpr size_t KCropWidth = 40;
+constexpr size_t KCropHeight = 10;
+Pipeline MakePipeline() {
+    Pipeline pipeline;
+    for (auto& filter : test_images::MakeSharpBlurEdge()) {
+        pipeline.AddFilter(std::move(filter));
+    }
+    return pipeline;
+}
+
+Image RunFilters(const Image& image) {
+    return test_images::RunFilters(test_images::MakeSharpBlurEdge(), image);
+}
+
+}  // namespace
+
+TEST(PipelineTest, ProcessFloatBuffers) {
+    Image source = test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight);
+    std::vector<Pixel> input(test_images::KWideWidth * test_images::KWideHeight);
+    ExportImage(source, ImageBuffer{input.data(), test_images::KWideWidth, test_images::KWideHeight,
+                                    static_cast<std::ptrdiff_t>(test_images::KWideWidth * sizeof(Pixel)),
+                                    PixelFormat::RgbFloat});
+    std::vector<Pixel> output(input.size());
+    ImageBuffer input_buffer{input.data(), test_images::KWideWidth, test_images::KWideHeight,
+                             static_cast<std::ptrdiff_t>(test_images::KWideWidth * sizeof(Pixel)),
+                             PixelFormat::RgbFloat};
+    ImageBuffer output_buffer = input_buffer;
+    output_buffer.data = output.data();
+    MakePipeline().Process(input_buffer, output_buffer);
+    test_images::ExpectSameImage(RunFilters(source), ImportImage(output_buffer));
+}
+
+TEST(PipelineTest, EmptyChainDoesNotAliasInput) {
+    std::vector<Pixel> pixels(test_images::KWideWidth * test_images::KWideHeight);
+    ImageBuffer buffer{pixels.data(), test_images::KWideWidth, test_images::KWideHeight,
+                       static_cast<std::ptrdiff_t>(test_images::KWideWidth * sizeof(Pixel)), PixelFormat::RgbFloat};
+    Image image = Pipeline().Process(buffer);
+    EXPECT_NE(image.GetRow(0), pixels.data());
+    pixels[0] = Pixel(constants::FullIntensity, constants::FullIntensity, constants::FullIntensity);
+    EXPECT_EQ(image.GetPixel(0, 0), Pixel());
+}
+
+TEST(PipelineTest, TiledMatchesSequential) {
+    Image source = test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight);
+    Pipeline pipeline = MakePipeline();
+    Image sequential = pipeline.Process(source);
+    pipeline.SetTiled(true);
+    test_images::ExpectSameImage(sequential, pipeline.Process(source));
+}
+
+TEST(PipelineTest, OutputSizeMismatch) {
+    Pipeline pipeline;
+    pipeline.AddFilter(std::make_unique<CropFilter>(KCropWidth, KCropHeight));
+    SharedImage input = SharedImage::Create(test_images::KWideWidth, test_images::KWideHeight, PixelFormat::Bgr8);
+    SharedImage output = SharedImage::Create(test_images::KWideWidth, test_images::KWideHeight, PixelFormat::Bgr8);
+    EXPECT_THROW(pipeline.Process(input.GetBuffer(), output.GetBuffer()), std::invalid_argument);
+    EXPECT_EQ(pipeline.Process(input.GetBuffer()).GetWidth(), KCropWidth);
+}
+
+TEST(SharedImageTest, OpenMapsSameMemory) {
+    SharedImage image = SharedImage::Create(test_images::KWideWidth, test_images::KWideHeight, PixelFormat::Bgr8);
+    SharedImage other = SharedImage::Open(dup(image.GetFd()));
+    EXPECT_EQ(other.GetBuffer().width, test_images::KWideWidth);
+    EXPECT_EQ(other.GetBuffer().height, test_images::KWideHeight);
+    EXPECT_EQ(other.GetBuffer().stride, image.GetBuffer().stride);
+    static_cast<uint8_t*>(image.GetBuffer().data)[1] = UINT8_MAX;
+    EXPECT_EQ(static_cast<uint8_t*>(other.GetBuffer().data)[1], UINT8_MAX);
+}
+
+TEST(SharedImageTest, ProcessInAnotherProcess) {
+    Image source = test_images::MakePattern(test_images::KWideWidth, test_images::KWideHeight);
+    SharedImage input =
+        SharedImage::Create(test_images::KWideWidth, test_images::KWideHeight, PixelFormat::RgbFloat);
+    SharedImage output =
+        SharedImage::Create(test_images::KWideWidth, test_images::KWideHeight, PixelFormat::RgbFloat);
+    ExportImage(source, input.GetBuffer());
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        // Never let an exception reach gtest here, or the child would go on running the suite.
+        try {
+            SharedImage child_input = SharedImage::Open(dup(input.GetFd()));
+            SharedImage child_output = SharedImage::Open(dup(output.GetFd()));
+            MakePipeline().Process(child_input.GetBuffer(), child_output.GetBuffer());
+            _exit(0);
+        } catch (...) {
+            _exit(1);
+        }
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    test_images::ExpectSameImage(RunFilters(source), ImportImage(output.GetBuffer()));
+}
+
+#ifdef __linux__
+TEST(SharedImageTest, CannotBeResized) {
+    SharedImage image = SharedImage::Create(1, 1, PixelFormat::Bgr8);
+    EXPECT_NE(ftruncate(image.GetFd(), 1), 0);
+    EXPECT_EQ(errno, EPERM);
+}
+
+TEST(SharedImageTest, RejectsUnsealedMemory) {
+    SharedImage image = SharedImage::Create(1, 1, PixelFormat::Bgr8);
+    struct stat info;
+    ASSERT_EQ(fstat(image.GetFd(), &info), 0);
+    std::vector<char> bytes(static_cast<size_t>(info.st_size));
+    ASSERT_EQ(pread(image.GetFd(), bytes.data(), bytes.size(), 0), info.st_size);
+    int fd = memfd_create("unsealed", MFD_CLOEXEC);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, bytes.data(), bytes.size()), info.st_size);
+    EXPECT_THROW(SharedImage::Open(fd), std::runtime_error);
+}
+#else
+TEST(SharedImageTest, RejectsForeignMemory) {
+    SharedImage image = SharedImage::Create(1, 1, PixelFormat::Bgr8);
+    int fd = dup(image.GetFd());
+    ASSERT_EQ(ftruncate(fd, 1), 0);
+    EXPECT_THROW(SharedImage::Open(fd), std::runtime_error);
+}
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Filters.h"
+#include "Image.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace test_images {
+
+constexpr size_t KWideWidth = 67;
+constexpr size_t KWideHeight = 23;
+constexpr size_t KImageWidth = 150;
+constexpr size_t KImageHeight = 97;
+constexpr float KChainSigma = 1.0f;
+constexpr float KEdgeThreshold = 0.3f;
+constexpr size_t KPatternModulo = 257;
+constexpr size_t KRedStepX = 37;
+constexpr size_t KRedStepY = 11;
+constexpr size_t KGreenOffset = 5;
+constexpr size_t KBlueStepX = 3;
+constexpr size_t KBlueStepY = 91;
+constexpr float KPatternScale = 1.0f / 256.0f;
+
+inline Image MakePattern(size_t width, size_t height) {
+    Image image(width, height);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            float r = static_cast<float>((x * KRedStepX + y * KRedStepY) % KPatternModulo) * KPatternScale;
+            float g = static_cast<float>((x * y + KGreenOffset) % KPatternModulo) * KPatternScale;
+            float b = static_cast<float>((x * KBlueStepX + y * KBlueStepY) % KPatternModulo) * KPatternScale;
+            image.SetPixel(x, y, Pixel(r, g, b));
+        }
+    }
+    return image;
+}
+
+// The chain the scheduling tests compare against plain sequential filtering.
+inline std::vector<std::unique_ptr<Filter>> MakeSharpBlurEdge(float sigma = KChainSigma) {
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<SharpeningFilter>());
+    filters.push_back(std::make_unique<GaussianBlurFilter>(sigma));
+    filters.push_back(std::make_unique<EdgeDetectionFilter>(KEdgeThreshold));
+    return filters;
+}
+
+inline Image RunFilters(const std::vector<std::unique_ptr<Filter>>& filters, Image image) {
+    for (const auto& filter : filters) {
+        image = filter->Apply(image);
+    }
+    return image;
+}
+
+// Bit-exact: SIMD, tiled and incremental paths promise the same floats as the reference.
+inline void ExpectSameImage(const Image& expected, const Image& actual) {
+    ASSERT_EQ(expected.GetWidth(), actual.GetWidth());
+    ASSERT_EQ(expected.GetHeight(), actual.GetHeight());
+    for (size_t y = 0; y < expected.GetHeight(); ++y) {
+        const Pixel* expected_row = expected.GetRow(y);
+        const Pixel* actual_row = actual.GetRow(y);
+        for (size_t x = 0; x < expected.GetWidth(); ++x) {
+            ASSERT_EQ(std::memcmp(&expected_row[x], &actual_row[x], sizeof(Pixel)), 0)
+                << "at (" << x << ", " << y << "): expected (" << expected_row[x].r << ", " << expected_row[x].g
+                << ", " << expected_row[x].b << "), actual (" << actual_row[x].r << ", " << actual_row[x].g << ", "
+                << actual_row[x].b << ")";
+        }
+    }
+}
+
+}  // namespace test_images
@@ -0,0 +1,80 @@
+#include "Filters.h"
+#include "TileScheduler.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "TestImages.h"
+
+namespace {
+
+using test_images::KImageHeight;
+using test_images::KImageWidth;
+
+constexpr size_t KSmallTile = 16;
+constexpr size_t KOddTile = 23;
+constexpr size_t KPixelateBlock = 5;
+constexpr size_t KCropWidth = 120;
+constexpr size_t KCropHeight = 80;
+// Wider than the default so the blur halo spans several small tiles.
+constexpr float KSigma = 2.0f;
+
+std::vector<std::unique_ptr<Filter>> MakeSharpBlurEdge() {
+    return test_images::MakeSharpBlurEdge(KSigma);
+}
+
+void ExpectTiledMatchesSequential(const std::vector<std::unique_ptr<Filter>>& filters, size_t tile_size) {
+    Image input = test_images::MakePattern(KImageWidth, KImageHeight);
+    Image expected = test_images::RunFilters(filters, input);
+    TileScheduler scheduler(tile_size);
+    test_images::ExpectSameImage(expected, scheduler.Run(filters, input));
+}
+
+}  // namespace
+
+TEST(TileSchedulerTest, SharpBlurEdge) {
+    ExpectTiledMatchesSequential(MakeSharpBlurEdge(), KSmallTile);
+    ExpectTiledMatchesSequential(MakeSharpBlurEdge(), KOddTile);
+    ExpectTiledMatchesSequential(MakeSharpBlurEdge(), 0);
+}
+
+TEST(TileSchedulerTest, PixelateKeepsBlockAlignment) {
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<SharpeningFilter>());
+    filters.push_back(std::make_unique<PixelateFilter>(KPixelateBlock));
+    filters.push_back(std::make_unique<GaussianBlurFilter>(KSigma));
+    filters.push_back(std::make_unique<GrayscaleFilter>());
+    ExpectTiledMatchesSequential(filters, KOddTile);
+}
+
+TEST(TileSchedulerTest, CropSplitsChain) {
+    std::vector<std::unique_ptr<Filter>> filters;
+    filters.push_back(std::make_unique<NegativeFilter>());
+    filters.push_back(std::make_unique<SharpeningFilter>());
+    filters.push_back(std::make_unique<CropFilter>(KCropWidth, KCropHeight));
+    filters.push_back(std::make_unique<GaussianBlurFilter>(KSigma));
+    filters.push_back(std::make_unique<SharpeningFilter>());
+    ExpectTiledMatchesSequential(filters, KSmallTile);
+}
+
+TEST(TileSchedulerTest, EmptyImage) {
+    TileScheduler scheduler(KSmallTile);
+    Image output = scheduler.Run(MakeSharpBlurEdge(), Image(0, 0));
+    EXPECT_EQ(output.GetWidth(), 0);
+    EXPECT_EQ(output.GetHeight(), 0);
+}
+
+TEST(TileSchedulerTest, FullImageTrafficOnce) {
+    std::vector<std::unique_ptr<Filter>> filters = MakeSharpBlurEdge();
+    TileScheduler scheduler(KSmallTile);
+    scheduler.Run(filters, test_images::MakePattern(KImageWidth, KImageHeight));
+    const TileStats& stats = scheduler.GetStats();
+    size_t pixels = KImageWidth * KImageHeight;
+    size_t tiles_x = (KImageWidth + KSmallTile - 1) / KSmallTile;
+    size_t tiles_y = (KImageHeight + KSmallTile - 1) / KSmallTile;
+    EXPECT_EQ(stats.tiles, tiles_x * tiles_y);
+    EXPECT_EQ(stats.pixels_written, pixels);
+    EXPECT_GT(stats.pixels_read, pixels);
+    // Same estimate for the untiled chain: every filter reads and writes the whole image once,
+    // ignoring the temporaries the filters allocate internally.
+    EXPECT_LT(stats.pixels_read + stats.pixels_written, 2 * filters.size() * pixels);
+}